@@ -0,0 +1,52 @@
+// Minimal timing helpers shared by the benchmarks in this directory.
+#ifndef LYNIPV_BENCH_HPP
+#define LYNIPV_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace bench {
+
+// keeps the optimizer from removing a computation whose result is otherwise unused
+template<class T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+// best of `reps` runs of `fn`, in nanoseconds
+template<class F>
+double best_ns(F&& fn, int reps = 5) {
+    double best = 1e300;
+    for(int rep = 0; rep < reps; ++rep) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    return best;
+}
+
+// a small, fast and deterministic generator so that runs are comparable
+struct xorshift {
+    std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+    std::uint64_t operator()() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+inline void report(const char* name, double ns, std::size_t ops) {
+    std::printf("%-48s %12.2f ms %10.2f ns/op\n", name, ns / 1e6, ns / static_cast<double>(ops));
+}
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,135 @@
+// Backtracking on an inplace_vector stack: counting the solutions of the n queens problem depth first, where
+// every row pushes its candidate columns as a frame on one shared stack and drops the frame when it is done.
+// The frame is dropped with a pop_back loop, with rollback() to a checkpoint and with a checkpoint_guard.
+#include "bench.hpp"
+
+#include "inplace_vector.hpp"
+
+#include <cstdio>
+#include <memory>
+
+namespace {
+constexpr int max_queens = 16;
+constexpr std::size_t stack_capacity = max_queens * max_queens;
+
+std::size_t destroyed = 0;
+
+// a candidate with a destructor that does something, like an element that releases a resource
+struct tracked {
+    int col;
+    explicit tracked(int column) noexcept : col(column) {}
+    tracked(const tracked&) = default;
+    tracked& operator=(const tracked&) = default;
+    ~tracked() { ++destroyed; }
+    operator int() const noexcept { return col; } // NOLINT(google-explicit-constructor)
+};
+
+// the three ways of dropping a frame, each entered before a row pushes its candidates and left after them
+struct pop_back_loop {
+    template<class Stack>
+    static std::size_t enter(Stack& stack) {
+        return stack.size();
+    }
+    template<class Stack>
+    static void leave(Stack& stack, std::size_t size) {
+        while(stack.size() != size) stack.pop_back();
+    }
+    static std::size_t base(std::size_t size) { return size; }
+};
+struct rollback_to_checkpoint {
+    template<class Stack>
+    static typename Stack::marker enter(Stack& stack) {
+        return stack.checkpoint();
+    }
+    template<class Stack>
+    static void leave(Stack& stack, typename Stack::marker mark) {
+        stack.rollback(mark);
+    }
+    template<class Marker>
+    static std::size_t base(const Marker& mark) {
+        return mark.size();
+    }
+};
+struct checkpoint_guard {
+    template<class Stack>
+    static typename Stack::checkpoint_guard enter(Stack& stack) {
+        return stack.scoped_checkpoint();
+    }
+    template<class Stack, class Guard>
+    static void leave(Stack&, Guard&) {} // the guard rolls back when it goes out of scope
+    template<class Guard>
+    static std::size_t base(const Guard& guard) {
+        return guard.checkpoint().size();
+    }
+};
+
+template<class Undo, class Stack>
+long solve(Stack& stack, int queens, int row, unsigned cols, unsigned diag, unsigned anti) {
+    if(row == queens) return 1;
+    auto frame = Undo::enter(stack);
+    const unsigned all = (1U << queens) - 1;
+    for(unsigned free = all & ~(cols | diag | anti); free; free &= free - 1) {
+        stack.emplace_back(__builtin_ctz(free));
+    }
+    long count = 0;
+    for(std::size_t idx = Undo::base(frame); idx != stack.size(); ++idx) {
+        const unsigned bit = 1U << static_cast<int>(stack[idx]);
+        count += solve<Undo>(stack, queens, row + 1, cols | bit, (diag | bit) << 1, (anti | bit) >> 1);
+    }
+    Undo::leave(stack, frame);
+    return count;
+}
+
+template<class T, class Undo>
+void run(const char* name, int queens) {
+    auto stack = std::make_unique<lyn::inplace_vector<T, stack_capacity>>();
+    long solutions = 0;
+    const double ns = bench::best_ns([&] { solutions = solve<Undo>(*stack, queens, 0, 0, 0, 0); });
+    bench::do_not_optimize(solutions);
+    bench::report(name, ns, static_cast<std::size_t>(solutions));
+}
+
+template<class T>
+void compare(const char* type, int queens) {
+    std::printf("--- %d queens, %s candidates (ns per solution)\n", queens, type);
+    run<T, pop_back_loop>("pop_back loop", queens);
+    run<T, rollback_to_checkpoint>("rollback to a checkpoint", queens);
+    run<T, checkpoint_guard>("checkpoint_guard", queens);
+}
+
+// a parser trying alternatives: a run of elements is pushed speculatively and then dropped, without a search
+// around it to hide the cost of dropping them
+template<class T, class Undo>
+void speculate(const char* name, std::size_t run_length) {
+    constexpr std::size_t runs = 200'000;
+    auto stack = std::make_unique<lyn::inplace_vector<T, stack_capacity>>();
+    stack->emplace_back(0);
+    const double ns = bench::best_ns([&] {
+        for(std::size_t idx = 0; idx != runs; ++idx) {
+            auto frame = Undo::enter(*stack);
+            for(std::size_t elem = 0; elem != run_length; ++elem) stack->emplace_back(static_cast<int>(elem));
+            bench::clobber_memory();
+            Undo::leave(*stack, frame);
+        }
+    });
+    bench::report(name, ns, runs * run_length);
+}
+
+template<class T>
+void compare_speculation(const char* type, std::size_t run_length) {
+    std::printf("--- runs of %zu %s elements pushed and dropped (ns per element)\n", run_length, type);
+    speculate<T, pop_back_loop>("pop_back loop", run_length);
+    speculate<T, rollback_to_checkpoint>("rollback to a checkpoint", run_length);
+    speculate<T, checkpoint_guard>("checkpoint_guard", run_length);
+}
+} // namespace
+
+int main() {
+    for(int queens : {10, 12}) {
+        compare<int>("int", queens);
+        compare<tracked>("destructible", queens);
+    }
+    compare_speculation<int>("int", 64);
+    compare_speculation<tracked>("destructible", 64);
+    bench::do_not_optimize(destroyed);
+}
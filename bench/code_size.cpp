@@ -0,0 +1,62 @@
+// Code size benchmark: the same routines used with inplace_vectors of 32 capacities, written either as
+// templates on the capacity or as plain functions taking an inplace_vector_ref.
+// Built by 'make bench-code-size' with and without LYNIPV_BENCH_REF to compare the object sizes.
+#include "inplace_vector.hpp"
+#include "inplace_vector_ref.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#ifdef LYNIPV_BENCH_REF
+# define CAPACITY_GENERIC
+# define STRINGS lyn::inplace_vector_ref<std::string>
+#else
+# define CAPACITY_GENERIC template<std::size_t N>
+# define STRINGS lyn::inplace_vector<std::string, N>&
+#endif
+
+// keeps the smallest unique values
+CAPACITY_GENERIC
+void insert_sorted_unique(STRINGS vec, const std::string& value) {
+    const auto it = std::lower_bound(vec.begin(), vec.end(), value);
+    if(it != vec.end() && *it == value) return;
+    const auto idx = it - vec.begin();
+    if(vec.size() == vec.capacity()) {
+        if(it == vec.end()) return;
+        vec.pop_back();
+    }
+    vec.insert(vec.begin() + idx, value);
+}
+
+CAPACITY_GENERIC
+void drop_prefixed(STRINGS vec, char prefix) {
+    const auto it = std::remove_if(vec.begin(), vec.end(), [prefix](const std::string& str) { return str.front() == prefix; });
+    vec.erase(it, vec.end());
+}
+
+CAPACITY_GENERIC
+void pad(STRINGS vec, std::size_t count) {
+    vec.resize(std::min(count, vec.capacity()), std::string("padding"));
+}
+
+namespace {
+template<std::size_t N>
+std::size_t use(const std::string& value) {
+    lyn::inplace_vector<std::string, N> vec;
+    insert_sorted_unique(vec, value);
+    drop_prefixed(vec, 'x');
+    pad(vec, N / 2);
+    return vec.size();
+}
+
+template<std::size_t... Ns>
+std::size_t use_all(const std::string& value, std::index_sequence<Ns...>) {
+    return (use<Ns + 1>(value) + ...);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    return static_cast<int>(use_all(argv[argc - 1], std::make_index_sequence<32>{}));
+}
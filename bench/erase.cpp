@@ -0,0 +1,57 @@
+// Filtering an inplace_vector<int32_t, 1024> at different selectivities: std::remove_if followed by erase,
+// lyn::erase_if with its branchless compaction and lyn::erase with the SIMD compaction of the target.
+#include "bench.hpp"
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+using vec_type = lyn::inplace_vector<std::int32_t, 1024>;
+constexpr std::size_t reps = 20000;
+
+vec_type make(unsigned percent) {
+    bench::xorshift rng;
+    vec_type vec;
+    while(vec.size() != vec.capacity()) vec.push_back(rng() % 100 < percent ? 0 : static_cast<std::int32_t>(rng() % 1000 + 1));
+    return vec;
+}
+
+template<class F>
+double run(const vec_type& source, F&& filter) {
+    vec_type vec;
+    return bench::best_ns([&] {
+        for(std::size_t rep = 0; rep != reps; ++rep) {
+            vec = source;
+            bench::clobber_memory();
+            bench::do_not_optimize(filter(vec));
+        }
+    });
+}
+} // namespace
+
+int main() {
+    char name[64];
+    for(unsigned percent : {0U, 10U, 50U, 90U, 100U}) {
+        const auto source = make(percent);
+        const auto ops = reps * source.size();
+        std::snprintf(name, sizeof name, "std::remove_if + erase, %u%% removed", percent);
+        bench::report(name, run(source, [](vec_type& vec) {
+                          auto it = std::remove_if(vec.begin(), vec.end(), [](std::int32_t val) { return val == 0; });
+                          auto removed = vec.end() - it;
+                          vec.erase(it, vec.end());
+                          return removed;
+                      }),
+                      ops);
+        std::snprintf(name, sizeof name, "lyn::erase_if, %u%% removed", percent);
+        bench::report(name, run(source, [](vec_type& vec) { return lyn::erase_if(vec, [](std::int32_t val) { return val == 0; }); }),
+                      ops);
+        std::snprintf(name, sizeof name, "lyn::erase, %u%% removed", percent);
+        bench::report(name, run(source, [](vec_type& vec) { return lyn::erase(vec, 0); }), ops);
+        const auto copy_only = run(source, [](vec_type& vec) { return vec.size(); });
+        std::snprintf(name, sizeof name, "(copying the input), %u%%", percent);
+        bench::report(name, copy_only, ops);
+    }
+}
@@ -0,0 +1,97 @@
+// Ping-pong latency: two coroutines bouncing a value over a pair of lyn::inplace_channel, versus two
+// threads doing the same over a mutex and condition variable protected lyn::inplace_vector queue.
+#include "bench.hpp"
+
+#include "inplace_channel.hpp"
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace {
+constexpr std::size_t rounds = 1'000'000;
+
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+using channel = lyn::inplace_channel<std::uint64_t, 1>;
+
+task ping(channel& out, channel& in) {
+    for(std::uint64_t idx = 0; idx != rounds; ++idx) {
+        co_await out.send(idx);
+        auto reply = co_await in.receive();
+        bench::do_not_optimize(reply);
+    }
+    out.close();
+}
+
+task pong(channel& in, channel& out) {
+    while(auto value = co_await in.receive()) co_await out.send(*value + 1);
+}
+
+double coroutines() {
+    return bench::best_ns([] {
+        channel there, back;
+        auto responder = pong(there, back);
+        auto initiator = ping(there, back);
+        responder.handle.resume();
+        initiator.handle.resume();
+        responder.handle.destroy();
+        initiator.handle.destroy();
+    });
+}
+
+struct locked_queue {
+    std::mutex mtx;
+    std::condition_variable cv;
+    lyn::inplace_vector<std::uint64_t, 1> items;
+
+    void push(std::uint64_t value) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            items.push_back(value);
+        }
+        cv.notify_one();
+    }
+    std::uint64_t pop() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return !items.empty(); });
+        auto value = items.back();
+        items.pop_back();
+        return value;
+    }
+};
+
+double threads() {
+    return bench::best_ns(
+        [] {
+            locked_queue there, back;
+            std::thread responder([&] {
+                for(std::size_t idx = 0; idx != rounds; ++idx) back.push(there.pop() + 1);
+            });
+            for(std::uint64_t idx = 0; idx != rounds; ++idx) {
+                there.push(idx);
+                bench::do_not_optimize(back.pop());
+            }
+            responder.join();
+        },
+        1);
+}
+} // namespace
+
+int main() {
+    std::printf("--- %zu round trips\n", rounds);
+    bench::report("lyn::inplace_channel, coroutines", coroutines(), rounds);
+    bench::report("mutex + condition_variable, threads", threads(), rounds);
+}
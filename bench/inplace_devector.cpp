@@ -0,0 +1,82 @@
+// Prepending protocol headers to a payload: lyn::inplace_devector versus insert(begin(), ...) on
+// lyn::inplace_vector, which moves the whole payload for every header. Also single elements pushed at the
+// front, which makes the inplace_vector quadratic.
+#include "bench.hpp"
+
+#include "inplace_devector.hpp"
+
+#include <cstdio>
+#include <memory>
+
+namespace {
+constexpr std::size_t capacity = 2048;
+constexpr int packets = 200'000;
+
+// udp, ipv4 and ethernet headers, innermost first
+const unsigned char udp[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+const unsigned char ipv4[20] = {0x45, 0, 0, 0, 0, 0, 0x40, 0, 64, 17};
+const unsigned char ethernet[14] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 2, 0, 0, 0, 0, 1, 8, 0};
+
+template<class Packet>
+void add_headers(Packet& packet) {
+    packet.insert(packet.begin(), std::begin(udp), std::end(udp));
+    packet.insert(packet.begin(), std::begin(ipv4), std::end(ipv4));
+    packet.insert(packet.begin(), std::begin(ethernet), std::end(ethernet));
+}
+
+template<class Packet, class Prepare>
+double build_packets(const unsigned char* payload, std::size_t payload_size, Prepare prepare) {
+    auto packet = std::make_unique<Packet>();
+    return bench::best_ns([&] {
+        for(int idx = 0; idx != packets; ++idx) {
+            packet->clear();
+            prepare(*packet);
+            packet->insert(packet->end(), payload, payload + payload_size);
+            add_headers(*packet);
+            bench::do_not_optimize(packet->data());
+        }
+    });
+}
+
+void header_prepend(std::size_t payload_size) {
+    std::printf("--- 3 headers prepended to a %zu byte payload\n", payload_size);
+    unsigned char payload[capacity];
+    for(std::size_t idx = 0; idx != payload_size; ++idx) payload[idx] = static_cast<unsigned char>(idx);
+    using vector = lyn::inplace_vector<unsigned char, capacity>;
+    using devector = lyn::inplace_devector<unsigned char, capacity>;
+    bench::report("lyn::inplace_vector insert at begin", build_packets<vector>(payload, payload_size, [](vector&) {}), packets);
+    bench::report("lyn::inplace_devector, recentered on demand",
+                  build_packets<devector>(payload, payload_size, [](devector& packet) { packet.recenter(0); }), packets);
+    bench::report("lyn::inplace_devector, 64 bytes of headroom",
+                  build_packets<devector>(payload, payload_size, [](devector& packet) { packet.recenter(64); }), packets);
+}
+
+template<class Container, class PushFront>
+double push_fronts(std::size_t count, int rounds, PushFront push_front) {
+    auto cont = std::make_unique<Container>();
+    return bench::best_ns([&] {
+        for(int round = 0; round != rounds; ++round) {
+            cont->clear();
+            for(std::size_t idx = 0; idx != count; ++idx) push_front(*cont, static_cast<int>(idx));
+            bench::do_not_optimize(cont->data());
+        }
+    });
+}
+} // namespace
+
+int main() {
+    header_prepend(64);
+    header_prepend(512);
+    header_prepend(1400);
+
+    constexpr std::size_t count = 1000;
+    constexpr int rounds = 2000;
+    std::printf("--- %zu ints pushed at the front\n", count);
+    using vector = lyn::inplace_vector<int, count>;
+    using devector = lyn::inplace_devector<int, count>;
+    bench::report("lyn::inplace_vector insert at begin",
+                  push_fronts<vector>(count, rounds, [](vector& vec, int value) { vec.insert(vec.begin(), value); }),
+                  count * rounds);
+    bench::report("lyn::inplace_devector push_front",
+                  push_fronts<devector>(count, rounds, [](devector& dv, int value) { dv.push_front(value); }), count * rounds);
+}
@@ -0,0 +1,64 @@
+// Random lookups in inplace_eytzinger versus std::lower_bound on the sorted inplace_vector it was built
+// from, for tables that fit in L1, L2 and L3 and one that does not fit in L2.
+#include "bench.hpp"
+
+#include "inplace_eytzinger.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr std::size_t lookups = 4'000'000;
+
+template<std::size_t N>
+void run() {
+    using sorted_type = lyn::inplace_vector<std::uint32_t, N>;
+    std::printf("--- %zu keys, %zu KiB\n", N, N * sizeof(std::uint32_t) / 1024);
+
+    bench::xorshift rng;
+    std::unique_ptr<sorted_type> sorted(new sorted_type);
+    for(std::size_t idx = 0; idx != N; ++idx) sorted->push_back(static_cast<std::uint32_t>(rng()) | 1U);
+    std::sort(sorted->begin(), sorted->end());
+    std::unique_ptr<lyn::inplace_eytzinger<std::uint32_t, N>> index(new lyn::inplace_eytzinger<std::uint32_t, N>(*sorted));
+
+    std::vector<std::uint32_t> probes(lookups);
+    for(auto& probe : probes) probe = static_cast<std::uint32_t>(rng());
+
+    bench::report("std::lower_bound",
+                  bench::best_ns([&] {
+                      std::size_t sum = 0;
+                      for(auto probe : probes) {
+                          sum += static_cast<std::size_t>(std::lower_bound(sorted->begin(), sorted->end(), probe) - sorted->begin());
+                      }
+                      bench::do_not_optimize(sum);
+                  }),
+                  lookups);
+
+    bench::report("inplace_eytzinger::rank",
+                  bench::best_ns([&] {
+                      std::size_t sum = 0;
+                      for(auto probe : probes) sum += index->rank(probe);
+                      bench::do_not_optimize(sum);
+                  }),
+                  lookups);
+
+    bench::report("inplace_eytzinger::contains",
+                  bench::best_ns([&] {
+                      std::size_t sum = 0;
+                      for(auto probe : probes) sum += index->contains(probe);
+                      bench::do_not_optimize(sum);
+                  }),
+                  lookups);
+}
+} // namespace
+
+int main() {
+    run<1024>();     // 4 KiB, L1
+    run<16384>();    // 64 KiB, L2
+    run<262144>();   // 1 MiB, L2
+    run<4194304>();  // 16 MiB, L3
+    run<33554432>(); // 128 MiB, L3 on large server parts, otherwise memory
+}
@@ -0,0 +1,63 @@
+// Order preserving erase and insert in the middle: lyn::inplace_list versus std::list and lyn::inplace_vector.
+#include "bench.hpp"
+
+#include "inplace_list.hpp"
+
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace {
+struct order {
+    std::uint64_t id;
+    std::uint64_t price;
+    std::uint64_t quantity;
+};
+
+constexpr std::size_t count = 4096;
+constexpr std::size_t ops = 1'000'000;
+
+// erases a random element and inserts a new one before another random element, using iterators kept
+// on the side like an order book keeps them per order id
+template<class List>
+double churn_list() {
+    auto lst = std::make_unique<List>();
+    std::vector<typename List::iterator> handles;
+    for(std::size_t idx = 0; idx != count; ++idx) {
+        lst->push_back(order{idx, idx, idx});
+        handles.push_back(std::prev(lst->end()));
+    }
+    bench::xorshift rng;
+    return bench::best_ns([&] {
+        for(std::size_t op = 0; op != ops; ++op) {
+            auto victim = rng() % count;
+            auto before = rng() % count;
+            lst->erase(handles[victim]);
+            if(before == victim) before = (before + 1) % count;
+            handles[victim] = lst->insert(handles[before], order{op, op, op});
+        }
+        bench::do_not_optimize(lst->front());
+    });
+}
+
+double churn_vector() {
+    auto vec = std::make_unique<lyn::inplace_vector<order, count>>();
+    for(std::size_t idx = 0; idx != count; ++idx) vec->push_back(order{idx, idx, idx});
+    bench::xorshift rng;
+    return bench::best_ns([&] {
+        for(std::size_t op = 0; op != ops; ++op) {
+            vec->erase(vec->begin() + static_cast<std::ptrdiff_t>(rng() % count));
+            vec->insert(vec->begin() + static_cast<std::ptrdiff_t>(rng() % (count - 1)), order{op, op, op});
+        }
+        bench::do_not_optimize(vec->front());
+    });
+}
+} // namespace
+
+int main() {
+    std::printf("--- erase + insert at random positions, %zu elements of %zu bytes\n", count, sizeof(order));
+    bench::report("lyn::inplace_list", churn_list<lyn::inplace_list<order, count>>(), ops);
+    bench::report("std::list", churn_list<std::list<order>>(), ops);
+    bench::report("lyn::inplace_vector", churn_vector(), ops);
+}
@@ -0,0 +1,83 @@
+// A 256 entry memo cache: inplace_lru_cache versus the usual std::unordered_map of std::list iterators.
+// Hits look up keys that are cached, misses compute and insert keys that are not, evicting every time.
+#include "bench.hpp"
+
+#include "inplace_lru_cache.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::size_t entries = 256;
+constexpr std::size_t lookups = 4'000'000;
+
+double compute(std::uint64_t key) { return static_cast<double>(key) * 0.5; }
+
+// the map-plus-list cache, most recently used first
+class list_lru_cache {
+public:
+    template<class Factory>
+    double& get_or_emplace(std::uint64_t key, Factory factory) {
+        auto it = m_index.find(key);
+        if(it != m_index.end()) {
+            m_order.splice(m_order.begin(), m_order, it->second);
+            return it->second->second;
+        }
+        if(m_order.size() == entries) {
+            m_index.erase(m_order.back().first);
+            m_order.pop_back();
+        }
+        m_order.emplace_front(key, factory());
+        m_index.emplace(key, m_order.begin());
+        return m_order.front().second;
+    }
+
+private:
+    std::list<std::pair<std::uint64_t, double>> m_order;
+    std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, double>>::iterator> m_index;
+};
+
+template<class Cache>
+void run(const char* name, const std::vector<std::uint64_t>& hits, const std::vector<std::uint64_t>& misses) {
+    Cache cache;
+    for(std::size_t idx = 0; idx != entries; ++idx) cache.get_or_emplace(hits[idx], [&] { return compute(hits[idx]); });
+    char label[64];
+
+    std::snprintf(label, sizeof label, "%s hit", name);
+    bench::report(label,
+                  bench::best_ns([&] {
+                      double sum = 0;
+                      for(std::size_t idx = 0; idx != lookups; ++idx) {
+                          const auto key = hits[idx % entries];
+                          sum += cache.get_or_emplace(key, [key] { return compute(key); });
+                      }
+                      bench::do_not_optimize(sum);
+                  }),
+                  lookups);
+
+    std::snprintf(label, sizeof label, "%s miss", name);
+    bench::report(label,
+                  bench::best_ns([&] {
+                      double sum = 0;
+                      for(auto key : misses) sum += cache.get_or_emplace(key, [key] { return compute(key); });
+                      bench::do_not_optimize(sum);
+                  }),
+                  misses.size());
+}
+} // namespace
+
+int main() {
+    bench::xorshift rng;
+    // cycling through the cached keys always hits the least recently used entry, so every hit relinks
+    std::vector<std::uint64_t> hits(entries);
+    for(auto& key : hits) key = rng();
+    std::vector<std::uint64_t> misses(lookups);
+    for(auto& key : misses) key = rng();
+
+    run<lyn::inplace_lru_cache<std::uint64_t, double, entries>>("lyn::inplace_lru_cache", hits, misses);
+    run<list_lru_cache>("std::unordered_map + std::list", hits, misses);
+}
@@ -0,0 +1,71 @@
+// Short-lived std::pmr containers on inplace_memory_resource, on the default resource and on a
+// std::pmr::monotonic_buffer_resource over an array of the same size. Every round builds a vector of ints
+// one push_back at a time and a vector of strings, and the buffer resources are released after it.
+#include "bench.hpp"
+
+#include "inplace_memory_resource.hpp"
+
+#include <cstdio>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int rounds = 200'000;
+constexpr std::size_t buffer_bytes = 16384;
+
+void ints(std::pmr::memory_resource* resource) {
+    std::pmr::vector<int> vec(resource);
+    for(int idx = 0; idx != 256; ++idx) vec.push_back(idx);
+    bench::do_not_optimize(vec.data());
+}
+
+// strings too long for the small string optimization, created and dropped as in a parser
+void strings(std::pmr::memory_resource* resource) {
+    std::pmr::vector<std::pmr::string> strs(resource);
+    strs.reserve(16);
+    for(int idx = 0; idx != 64; ++idx) {
+        std::pmr::string str("a token that is longer than the small buffer", resource);
+        str += static_cast<char>('a' + idx % 26);
+        if(idx % 4 == 0) strs.push_back(std::move(str));
+    }
+    bench::do_not_optimize(strs.data());
+}
+
+template<class Work, class Release>
+void run(const char* name, Work work, std::pmr::memory_resource* resource, Release release) {
+    bench::report(name,
+                  bench::best_ns([&] {
+                      for(int round = 0; round != rounds; ++round) {
+                          work(resource);
+                          release();
+                      }
+                  }),
+                  rounds);
+}
+
+template<class Work>
+void compare(const char* workload, Work work) {
+    std::printf("--- %s\n", workload);
+    run("default resource", work, std::pmr::get_default_resource(), [] {});
+
+    static unsigned char buffer[buffer_bytes];
+    std::pmr::monotonic_buffer_resource monotonic(buffer, sizeof buffer);
+    run("std::pmr::monotonic_buffer_resource", work, &monotonic, [&] { monotonic.release(); });
+
+    static lyn::inplace_memory_resource<buffer_bytes> inplace;
+    run("lyn::inplace_memory_resource", work, &inplace, [] { inplace.release(); });
+    std::printf("%-48s %12zu bytes, %zu upstream fallbacks\n", "  high water mark", inplace.high_water_mark(),
+                inplace.upstream_fallbacks());
+
+    static lyn::inplace_memory_resource<buffer_bytes, alignof(std::max_align_t), false> bump_only;
+    run("lyn::inplace_memory_resource without size classes", work, &bump_only, [] { bump_only.release(); });
+    std::printf("%-48s %12zu bytes, %zu upstream fallbacks\n", "  high water mark", bump_only.high_water_mark(),
+                bump_only.upstream_fallbacks());
+}
+} // namespace
+
+int main() {
+    compare("std::pmr::vector<int>, 256 push_back", ints);
+    compare("std::pmr::string churn, 64 strings, 16 kept", strings);
+}
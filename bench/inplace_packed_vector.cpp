@@ -0,0 +1,127 @@
+// Flags and 4 bit codes in inplace_packed_vector versus one byte each in inplace_vector<std::uint8_t, N>:
+// the size of the objects, filling them with push_back, counting, finding every match and combining two
+// of them element by element.
+#include "bench.hpp"
+
+#include "inplace_packed_vector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+namespace {
+constexpr std::size_t count = 4096;
+constexpr int reps = 2000;
+
+template<std::size_t Bits>
+void run(const std::uint8_t (&values)[count], const std::uint8_t (&other)[count]) {
+    using packed = lyn::inplace_packed_vector<Bits, count>;
+    using bytes = lyn::inplace_vector<std::uint8_t, count>;
+    const auto value = static_cast<typename packed::value_type>(1);
+    std::printf("--- %zu bit elements, %zu of them: %zu bytes packed, %zu bytes in inplace_vector<uint8_t>\n", Bits, count,
+                sizeof(packed), sizeof(bytes));
+    constexpr std::size_t ops = count * reps;
+
+    packed pa, pb;
+    bytes ba, bb;
+    bench::report("packed push_back",
+                  bench::best_ns([&] {
+                      for(int rep = 0; rep != reps; ++rep) {
+                          pa.clear();
+                          for(auto val : values) pa.push_back(static_cast<typename packed::value_type>(val));
+                          bench::do_not_optimize(pa);
+                      }
+                  }),
+                  ops);
+    bench::report("bytes push_back",
+                  bench::best_ns([&] {
+                      for(int rep = 0; rep != reps; ++rep) {
+                          ba.clear();
+                          for(auto val : values) ba.push_back(val);
+                          bench::do_not_optimize(ba);
+                      }
+                  }),
+                  ops);
+    for(auto val : other) {
+        pb.push_back(static_cast<typename packed::value_type>(val));
+        bb.push_back(val);
+    }
+
+    bench::report("packed count(value)",
+                  bench::best_ns([&] {
+                      std::size_t sum = 0;
+                      for(int rep = 0; rep != reps; ++rep) {
+                          sum += pa.count(value);
+                          bench::clobber_memory();
+                      }
+                      bench::do_not_optimize(sum);
+                  }),
+                  ops);
+    bench::report("bytes std::count",
+                  bench::best_ns([&] {
+                      std::size_t sum = 0;
+                      for(int rep = 0; rep != reps; ++rep) {
+                          sum += static_cast<std::size_t>(std::count(ba.begin(), ba.end(), std::uint8_t{1}));
+                          bench::clobber_memory();
+                      }
+                      bench::do_not_optimize(sum);
+                  }),
+                  ops);
+
+    bench::report("packed find_next(pos, value) over all",
+                  bench::best_ns([&] {
+                      std::size_t sum = 0;
+                      for(int rep = 0; rep != reps; ++rep) {
+                          for(auto idx = pa.find_first(value); idx != packed::npos; idx = pa.find_next(idx + 1, value)) sum += idx;
+                          bench::clobber_memory();
+                      }
+                      bench::do_not_optimize(sum);
+                  }),
+                  ops);
+    bench::report("bytes std::find over all",
+                  bench::best_ns([&] {
+                      std::size_t sum = 0;
+                      for(int rep = 0; rep != reps; ++rep) {
+                          for(auto it = std::find(ba.begin(), ba.end(), std::uint8_t{1}); it != ba.end();
+                              it = std::find(it + 1, ba.end(), std::uint8_t{1})) {
+                              sum += static_cast<std::size_t>(it - ba.begin());
+                          }
+                          bench::clobber_memory();
+                      }
+                      bench::do_not_optimize(sum);
+                  }),
+                  ops);
+
+    bench::report("packed operator^=",
+                  bench::best_ns([&] {
+                      for(int rep = 0; rep != reps; ++rep) {
+                          pa ^= pb;
+                          bench::clobber_memory();
+                      }
+                  }),
+                  ops);
+    bench::report("bytes std::transform with bit_xor",
+                  bench::best_ns([&] {
+                      for(int rep = 0; rep != reps; ++rep) {
+                          std::transform(ba.begin(), ba.end(), bb.begin(), ba.begin(), std::bit_xor<std::uint8_t>{});
+                          bench::clobber_memory();
+                      }
+                  }),
+                  ops);
+}
+
+std::uint8_t flags[count], flags2[count], codes[count], codes2[count];
+} // namespace
+
+int main() {
+    bench::xorshift rng;
+    for(std::size_t idx = 0; idx != count; ++idx) {
+        flags[idx] = static_cast<std::uint8_t>(rng() % 8 == 0); // sparse, as in a filter
+        flags2[idx] = static_cast<std::uint8_t>(rng() & 1);
+        codes[idx] = static_cast<std::uint8_t>(rng() & 15);
+        codes2[idx] = static_cast<std::uint8_t>(rng() & 15);
+    }
+    run<1>(flags, flags2);
+    run<4>(codes, codes2);
+}
@@ -0,0 +1,79 @@
+// Sorted neighbour list operations: lyn set algorithms versus the std algorithms appending to the same
+// lyn::inplace_vector through std::back_inserter.
+#include "bench.hpp"
+
+#include "inplace_set_algorithm.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+namespace {
+constexpr std::size_t capacity = 4096;
+constexpr std::size_t pairs = 64;
+constexpr int reps = 200;
+
+using list = lyn::inplace_vector<std::uint32_t, capacity>;
+using result = lyn::inplace_vector<std::uint32_t, 2 * capacity>;
+
+// count elements out of [0, range), so that about count / range of the elements are shared
+std::vector<list> make_lists(std::size_t count, std::uint32_t range, bench::xorshift& rng) {
+    std::vector<list> lists(pairs);
+    for(auto& lst : lists) {
+        while(lst.size() != count) lst.push_back(static_cast<std::uint32_t>(rng() % range));
+        std::sort(lst.begin(), lst.end());
+        lst.erase(std::unique(lst.begin(), lst.end()), lst.end());
+    }
+    return lists;
+}
+
+template<class F>
+double run(const std::vector<list>& as, const std::vector<list>& bs, F op) {
+    result out;
+    return bench::best_ns([&] {
+        for(int rep = 0; rep != reps; ++rep) {
+            for(std::size_t idx = 0; idx != pairs; ++idx) {
+                out.clear();
+                op(as[idx], bs[idx], out);
+                bench::do_not_optimize(out.size());
+            }
+        }
+    });
+}
+
+void compare(const char* title, std::size_t na, std::size_t nb, std::uint32_t range) {
+    bench::xorshift rng;
+    auto as = make_lists(na, range, rng);
+    auto bs = make_lists(nb, range, rng);
+    const std::size_t ops = reps * pairs * (na + nb);
+    std::printf("--- %s: %zu and %zu elements out of %u\n", title, na, nb, range);
+    bench::report("lyn::set_intersection", run(as, bs, [](const list& a, const list& b, result& out) { lyn::set_intersection(a, b, out); }), ops);
+    bench::report("std::set_intersection", run(as, bs, [](const list& a, const list& b, result& out) {
+                      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+                  }), ops);
+    bench::report("lyn::intersection_size", run(as, bs, [](const list& a, const list& b, result& out) {
+                      auto count = lyn::intersection_size(a, b);
+                      bench::do_not_optimize(count);
+                      static_cast<void>(out);
+                  }), ops);
+    bench::report("lyn::set_union", run(as, bs, [](const list& a, const list& b, result& out) { lyn::set_union(a, b, out); }), ops);
+    bench::report("std::set_union", run(as, bs, [](const list& a, const list& b, result& out) {
+                      std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+                  }), ops);
+    bench::report("lyn::set_difference", run(as, bs, [](const list& a, const list& b, result& out) { lyn::set_difference(a, b, out); }), ops);
+    bench::report("std::set_difference", run(as, bs, [](const list& a, const list& b, result& out) {
+                      std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+                  }), ops);
+    bench::report("lyn::merge", run(as, bs, [](const list& a, const list& b, result& out) { lyn::merge(a, b, out); }), ops);
+    bench::report("std::merge", run(as, bs, [](const list& a, const list& b, result& out) {
+                      std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+                  }), ops);
+}
+} // namespace
+
+int main() {
+    compare("similar sizes, sparse overlap", 2048, 2048, 1U << 16);
+    compare("similar sizes, dense overlap", 2048, 2048, 4096);
+    compare("skewed sizes", 32, 4096, 1U << 16);
+}
@@ -0,0 +1,97 @@
+// Iteration and random erase + insert: lyn::inplace_slot_map versus std::unordered_map keyed on an id.
+#include "bench.hpp"
+
+#include "inplace_slot_map.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+struct particle {
+    float pos[3];
+    float vel[3];
+};
+
+constexpr std::size_t count = 8192;
+constexpr std::size_t ops = 1'000'000;
+constexpr std::size_t sweeps = 1000;
+
+using slot_map = lyn::inplace_slot_map<particle, count>;
+
+particle make(std::size_t idx) {
+    auto val = static_cast<float>(idx);
+    return particle{{val, val, val}, {1, 2, 3}};
+}
+
+double iterate_slot_map() {
+    auto map = std::make_unique<slot_map>();
+    for(std::size_t idx = 0; idx != count; ++idx) map->insert(make(idx));
+    return bench::best_ns([&] {
+        for(std::size_t sweep = 0; sweep != sweeps; ++sweep) {
+            for(auto& prt : *map) {
+                for(int dim = 0; dim != 3; ++dim) prt.pos[dim] += prt.vel[dim];
+            }
+            bench::clobber_memory();
+        }
+    });
+}
+
+double iterate_unordered_map() {
+    std::unordered_map<std::uint32_t, particle> map;
+    for(std::size_t idx = 0; idx != count; ++idx) map.emplace(static_cast<std::uint32_t>(idx), make(idx));
+    return bench::best_ns([&] {
+        for(std::size_t sweep = 0; sweep != sweeps; ++sweep) {
+            for(auto& kv : map) {
+                for(int dim = 0; dim != 3; ++dim) kv.second.pos[dim] += kv.second.vel[dim];
+            }
+            bench::clobber_memory();
+        }
+    });
+}
+
+double churn_slot_map() {
+    auto map = std::make_unique<slot_map>();
+    std::vector<slot_map::handle> handles;
+    for(std::size_t idx = 0; idx != count; ++idx) handles.push_back(map->insert(make(idx)));
+    bench::xorshift rng;
+    return bench::best_ns([&] {
+        for(std::size_t op = 0; op != ops; ++op) {
+            auto& hnd = handles[rng() % count];
+            map->erase(hnd);
+            hnd = map->insert(make(op));
+        }
+        bench::do_not_optimize(*map->begin());
+    });
+}
+
+double churn_unordered_map() {
+    std::unordered_map<std::uint32_t, particle> map;
+    std::vector<std::uint32_t> ids;
+    std::uint32_t next_id = 0;
+    for(std::size_t idx = 0; idx != count; ++idx) {
+        map.emplace(next_id, make(idx));
+        ids.push_back(next_id++);
+    }
+    bench::xorshift rng;
+    return bench::best_ns([&] {
+        for(std::size_t op = 0; op != ops; ++op) {
+            auto& id = ids[rng() % count];
+            map.erase(id);
+            id = next_id++;
+            map.emplace(id, make(op));
+        }
+        bench::do_not_optimize(map.begin()->second);
+    });
+}
+} // namespace
+
+int main() {
+    std::printf("--- iterate and update %zu elements of %zu bytes, %zu sweeps\n", count, sizeof(particle), sweeps);
+    bench::report("lyn::inplace_slot_map", iterate_slot_map(), count * sweeps);
+    bench::report("std::unordered_map", iterate_unordered_map(), count * sweeps);
+    std::printf("--- erase + insert at random handles\n");
+    bench::report("lyn::inplace_slot_map", churn_slot_map(), ops);
+    bench::report("std::unordered_map", churn_unordered_map(), ops);
+}
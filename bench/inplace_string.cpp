@@ -0,0 +1,84 @@
+// Short keys: lyn::inplace_string<23> versus std::string. Keys are 6 to 22 characters, so some of them
+// exceed the small string buffer of std::string.
+#include "bench.hpp"
+
+#include "inplace_string.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+template<class String>
+void run(const char* type, const std::vector<std::string>& keys) {
+    std::printf("--- %s, %zu keys\n", type, keys.size());
+    char name[64];
+    std::vector<String> strs;
+    strs.reserve(keys.size());
+
+    std::snprintf(name, sizeof name, "construct from const char*");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      strs.clear();
+                      for(auto& key : keys) strs.emplace_back(key.c_str());
+                      bench::do_not_optimize(strs.back());
+                  }),
+                  keys.size());
+
+    std::snprintf(name, sizeof name, "copy");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      std::vector<String> copy(strs);
+                      bench::do_not_optimize(copy.back());
+                  }),
+                  keys.size());
+
+    std::snprintf(name, sizeof name, "append");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      for(auto& str : strs) {
+                          str.clear();
+                          str.append("key:");
+                          str.append("0123456789", 10);
+                      }
+                      bench::do_not_optimize(strs.back());
+                  }),
+                  keys.size());
+
+    strs.clear();
+    for(auto& key : keys) strs.emplace_back(key.c_str());
+    std::snprintf(name, sizeof name, "sort");
+    bench::report(name,
+                  bench::best_ns(
+                      [&] {
+                          auto copy = strs;
+                          std::sort(copy.begin(), copy.end());
+                          bench::do_not_optimize(copy.front());
+                      },
+                      3),
+                  keys.size());
+
+    std::unordered_set<String> set(strs.begin(), strs.end());
+    std::snprintf(name, sizeof name, "unordered_set::find");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      std::size_t found = 0;
+                      for(auto& str : strs) found += set.count(str);
+                      bench::do_not_optimize(found);
+                  }),
+                  keys.size());
+}
+} // namespace
+
+int main() {
+    bench::xorshift rng;
+    std::vector<std::string> keys(1'000'000);
+    for(auto& key : keys) {
+        key.resize(6 + rng() % 17);
+        for(auto& ch : key) ch = static_cast<char>('a' + rng() % 26);
+    }
+    run<std::string>("std::string", keys);
+    run<lyn::inplace_string<23>>("lyn::inplace_string<23>", keys);
+}
@@ -0,0 +1,86 @@
+// A small per-request map: build, look up and tear down, for lyn::inplace_unordered_map versus
+// std::unordered_map and a linear scan over a lyn::inplace_vector of pairs.
+#include "bench.hpp"
+
+#include "inplace_unordered_map.hpp"
+
+#include <cstdio>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::size_t requests = 20000;
+constexpr std::size_t lookups_per_key = 4;
+
+template<std::size_t N>
+struct linear_map {
+    lyn::inplace_vector<std::pair<std::uint64_t, std::uint64_t>, N> pairs;
+
+    void insert(std::uint64_t key, std::uint64_t value) { pairs.emplace_back(key, value); }
+    const std::uint64_t* find(std::uint64_t key) const {
+        for(auto& kv : pairs) {
+            if(kv.first == key) return &kv.second;
+        }
+        return nullptr;
+    }
+};
+
+template<std::size_t N>
+struct adapter_inplace {
+    lyn::inplace_unordered_map<std::uint64_t, std::uint64_t, N> map;
+    void insert(std::uint64_t key, std::uint64_t value) { map.try_emplace(key, value); }
+    const std::uint64_t* find(std::uint64_t key) const {
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+};
+
+struct adapter_std {
+    std::unordered_map<std::uint64_t, std::uint64_t> map;
+    void insert(std::uint64_t key, std::uint64_t value) { map.emplace(key, value); }
+    const std::uint64_t* find(std::uint64_t key) const {
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+};
+
+// every request builds a map of `count` entries and looks up each key a few times, half of the lookups
+// missing
+template<class Map>
+double per_request(std::size_t count) {
+    bench::xorshift rng;
+    std::vector<std::uint64_t> keys(count * 2);
+    return bench::best_ns([&] {
+        std::uint64_t sum = 0;
+        for(std::size_t req = 0; req != requests; ++req) {
+            for(auto& key : keys) key = rng();
+            Map map;
+            for(std::size_t idx = 0; idx != count; ++idx) map.insert(keys[idx], idx);
+            for(std::size_t rep = 0; rep != lookups_per_key; ++rep) {
+                for(auto key : keys) {
+                    if(auto val = map.find(key)) sum += *val;
+                }
+            }
+            bench::do_not_optimize(map);
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+template<std::size_t N>
+void run() {
+    std::printf("--- %zu entries, build + %zu lookups per entry\n", N, lookups_per_key * 2);
+    const std::size_t ops = requests * N * (1 + lookups_per_key * 2);
+    bench::report("lyn::inplace_unordered_map", per_request<adapter_inplace<N>>(N), ops);
+    bench::report("std::unordered_map", per_request<adapter_std>(N), ops);
+    bench::report("lyn::inplace_vector linear scan", per_request<linear_map<N>>(N), ops);
+}
+} // namespace
+
+int main() {
+    run<8>();
+    run<16>();
+    run<64>();
+    run<256>();
+}
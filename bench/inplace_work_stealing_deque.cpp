@@ -0,0 +1,105 @@
+// Fork-join tree sum over 1, 2, 4 ... hardware_concurrency workers: per-worker lyn::inplace_work_stealing_deque
+// versus per-worker std::deque behind a mutex. A worker splits its range in half, pushes one half for
+// others to steal and keeps going with the other, summing ranges below the grain size directly.
+#include "bench.hpp"
+
+#include "inplace_work_stealing_deque.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr std::uint32_t elements = 1U << 24;
+constexpr std::uint32_t grain = 2048;
+
+struct range {
+    std::uint32_t first;
+    std::uint32_t last;
+};
+
+struct chase_lev {
+    lyn::inplace_work_stealing_deque<range, 64> deq;
+    bool push(range rng) { return deq.try_push(rng); }
+    bool pop(range& rng) { return deq.pop(rng); }
+    bool steal(range& rng) { return deq.steal(rng); }
+};
+
+struct locked_deque {
+    std::mutex mtx;
+    std::deque<range> deq;
+    bool push(range rng) {
+        std::lock_guard<std::mutex> lock(mtx);
+        deq.push_back(rng);
+        return true;
+    }
+    bool pop(range& rng) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(deq.empty()) return false;
+        rng = deq.back();
+        deq.pop_back();
+        return true;
+    }
+    bool steal(range& rng) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(deq.empty()) return false;
+        rng = deq.front();
+        deq.pop_front();
+        return true;
+    }
+};
+
+template<class Deque>
+double tree_sum(const std::vector<std::uint32_t>& data, unsigned workers) {
+    return bench::best_ns([&] {
+        std::vector<std::unique_ptr<Deque>> deques;
+        for(unsigned idx = 0; idx != workers; ++idx) deques.push_back(std::make_unique<Deque>());
+        std::atomic<std::uint64_t> remaining{elements};
+        std::atomic<std::uint64_t> total{0};
+        deques[0]->push(range{0, elements});
+
+        auto work = [&](unsigned self) {
+            bench::xorshift rng;
+            rng.state += self;
+            std::uint64_t sum = 0;
+            range cur;
+            while(remaining.load(std::memory_order_acquire) != 0) {
+                if(!deques[self]->pop(cur) && !deques[rng() % workers]->steal(cur)) continue;
+                while(cur.last - cur.first > grain) {
+                    auto mid = cur.first + (cur.last - cur.first) / 2;
+                    if(!deques[self]->push(range{mid, cur.last})) break;
+                    cur.last = mid;
+                }
+                std::uint64_t part = 0;
+                for(auto idx = cur.first; idx != cur.last; ++idx) part += data[idx] * std::uint64_t{data[idx]};
+                sum += part;
+                remaining.fetch_sub(cur.last - cur.first, std::memory_order_acq_rel);
+            }
+            total.fetch_add(sum, std::memory_order_relaxed);
+        };
+        std::vector<std::thread> threads;
+        for(unsigned idx = 1; idx < workers; ++idx) threads.emplace_back(work, idx);
+        work(0);
+        for(auto& thr : threads) thr.join();
+        bench::do_not_optimize(total.load());
+    });
+}
+} // namespace
+
+int main() {
+    std::vector<std::uint32_t> data(elements);
+    bench::xorshift rng;
+    for(auto& value : data) value = static_cast<std::uint32_t>(rng());
+
+    const unsigned max_workers = std::max(1U, std::thread::hardware_concurrency());
+    for(unsigned workers = 1;; workers = std::min(workers * 2, max_workers)) {
+        std::printf("--- tree sum of %u elements, grain %u, %u workers\n", elements, grain, workers);
+        bench::report("lyn::inplace_work_stealing_deque", tree_sum<chase_lev>(data, workers), elements);
+        bench::report("std::deque + std::mutex", tree_sum<locked_deque>(data, workers), elements);
+        if(workers == max_workers) break;
+    }
+}
@@ -0,0 +1,37 @@
+// Compile time benchmark: instantiates inplace_vector and its special member functions for many (T, N) pairs.
+// Built by 'make bench-compile' with different standards to compare front-end time and object size.
+#include "inplace_vector.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace {
+struct copy_only {
+    copy_only() = default;
+    copy_only(const copy_only&) {}
+    copy_only& operator=(const copy_only&) { return *this; }
+};
+
+template<class T, std::size_t N>
+std::size_t use() {
+    lyn::inplace_vector<T, N> a;
+    a.emplace_back();
+    lyn::inplace_vector<T, N> b(a);
+    lyn::inplace_vector<T, N> c(std::move(b));
+    b = c;
+    a = std::move(c);
+    return a.size() + b.size() + c.size();
+}
+
+template<class T, std::size_t... Ns>
+std::size_t use_all(std::index_sequence<Ns...>) {
+    return (use<T, Ns + 1>() + ...);
+}
+} // namespace
+
+int main() {
+    using seq = std::make_index_sequence<100>;
+    return static_cast<int>(use_all<int>(seq{}) + use_all<double>(seq{}) + use_all<std::string>(seq{}) +
+                            use_all<copy_only>(seq{}));
+}
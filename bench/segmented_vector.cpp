@@ -0,0 +1,77 @@
+// Append tail latency: lyn::segmented_vector versus std::vector and std::deque. Every push_back is timed
+// on its own, so the percentiles show the cost of std::vector reallocating and copying its elements.
+#include "bench.hpp"
+
+#include "segmented_vector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+namespace {
+struct record {
+    std::uint64_t id;
+    double values[7];
+};
+
+constexpr std::size_t count = 4'000'000;
+
+template<class Container>
+void append_latency(const char* name) {
+    std::vector<double> latencies(count);
+    Container cont;
+    record rec{};
+    for(std::size_t idx = 0; idx != count; ++idx) {
+        rec.id = idx;
+        auto start = std::chrono::steady_clock::now();
+        cont.push_back(rec);
+        auto stop = std::chrono::steady_clock::now();
+        latencies[idx] = std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+    bench::do_not_optimize(cont.back());
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double frac) { return latencies[static_cast<std::size_t>(frac * static_cast<double>(count - 1))]; };
+    std::printf("%-40s p50 %8.0f ns  p99 %8.0f ns  p99.99 %10.0f ns  max %12.0f ns\n", name, pct(0.5), pct(0.99), pct(0.9999),
+                latencies.back());
+}
+
+double sum_segments(const lyn::segmented_vector<record, 1024>& seg) {
+    double sum = 0;
+    for(std::size_t idx = 0; idx != seg.chunk_count(); ++idx) {
+        for(auto& rec : seg.chunk(idx)) sum += rec.values[0];
+    }
+    return sum;
+}
+} // namespace
+
+int main() {
+    std::printf("push_back of %zu records of %zu bytes\n", count, sizeof(record));
+    append_latency<std::vector<record>>("std::vector<record>");
+    append_latency<std::deque<record>>("std::deque<record>");
+    append_latency<lyn::segmented_vector<record, 1024>>("lyn::segmented_vector<record, 1024>");
+
+    lyn::segmented_vector<record, 1024> seg;
+    std::vector<record> vec;
+    for(std::size_t idx = 0; idx != count; ++idx) {
+        seg.push_back(record{idx, {static_cast<double>(idx)}});
+        vec.push_back(record{idx, {static_cast<double>(idx)}});
+    }
+    double sum = 0;
+    bench::report("sum std::vector<record>", bench::best_ns([&] {
+                      for(auto& rec : vec) sum += rec.values[0];
+                      bench::do_not_optimize(sum);
+                  }),
+                  count);
+    bench::report("sum segmented_vector<record, 1024> by chunk", bench::best_ns([&] {
+                      sum += sum_segments(seg);
+                      bench::do_not_optimize(sum);
+                  }),
+                  count);
+    bench::report("sum segmented_vector<record, 1024> by index", bench::best_ns([&] {
+                      for(std::size_t idx = 0; idx != seg.size(); ++idx) sum += seg[idx].values[0];
+                      bench::do_not_optimize(sum);
+                  }),
+                  count);
+}
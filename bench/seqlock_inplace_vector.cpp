@@ -0,0 +1,94 @@
+// Reader scaling over 1, 2, 4 ... hardware_concurrency reader threads copying a 32 entry routing table
+// while one writer replaces it every 100 microseconds: lyn::seqlock_inplace_vector versus an inplace_vector
+// behind a std::shared_mutex, where every read writes the lock's reader count.
+#include "bench.hpp"
+
+#include "seqlock_inplace_vector.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+struct route {
+    std::uint32_t prefix;
+    std::uint32_t mask;
+    std::uint32_t next_hop;
+    std::uint32_t metric;
+};
+using table_type = lyn::inplace_vector<route, 32>;
+
+constexpr auto duration = std::chrono::milliseconds(300);
+
+table_type make_table(std::uint32_t generation) {
+    table_type table;
+    for(std::uint32_t idx = 0; idx != table.capacity(); ++idx) table.push_back(route{idx << 24, 0xFF000000U, generation, idx});
+    return table;
+}
+
+struct seqlocked {
+    lyn::seqlock_inplace_vector<route, 32> table{make_table(0)};
+    table_type read() const { return table.snapshot(); }
+    void write(const table_type& value) { table.store(value); }
+};
+
+struct shared_locked {
+    mutable std::shared_mutex mtx;
+    table_type table = make_table(0);
+    table_type read() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return table;
+    }
+    void write(const table_type& value) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        table = value;
+    }
+};
+
+// total reads per second over all readers
+template<class Table>
+double reads_per_second(unsigned readers) {
+    Table table;
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::vector<std::thread> threads;
+    for(unsigned idx = 0; idx != readers; ++idx) {
+        threads.emplace_back([&] {
+            std::uint64_t count = 0;
+            std::uint32_t sum = 0;
+            while(!done.load(std::memory_order_relaxed)) {
+                const auto snap = table.read();
+                sum += snap[static_cast<std::size_t>(count % 32)].next_hop;
+                ++count;
+            }
+            bench::do_not_optimize(sum);
+            reads.fetch_add(count, std::memory_order_relaxed);
+        });
+    }
+    std::thread writer([&] {
+        for(std::uint32_t generation = 1; !done.load(std::memory_order_relaxed); ++generation) {
+            table.write(make_table(generation));
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    std::this_thread::sleep_for(duration);
+    done.store(true);
+    for(auto& thr : threads) thr.join();
+    writer.join();
+    return static_cast<double>(reads.load()) / std::chrono::duration<double>(duration).count();
+}
+} // namespace
+
+int main() {
+    const unsigned max_readers = std::max(1U, std::thread::hardware_concurrency());
+    for(unsigned readers = 1;; readers = std::min(readers * 2, max_readers)) {
+        std::printf("--- %u readers, one writer\n", readers);
+        std::printf("%-48s %12.2f Mreads/s\n", "lyn::seqlock_inplace_vector", reads_per_second<seqlocked>(readers) / 1e6);
+        std::printf("%-48s %12.2f Mreads/s\n", "inplace_vector + std::shared_mutex", reads_per_second<shared_locked>(readers) / 1e6);
+        if(readers == max_readers) break;
+    }
+}
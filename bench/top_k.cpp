@@ -0,0 +1,71 @@
+// Top-K selection out of a large stream: inplace_top_k versus std::partial_sort and std::nth_element.
+#include "bench.hpp"
+
+#include "inplace_top_k.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace {
+template<std::size_t K, class T>
+void run(const char* type, const std::vector<T>& data) {
+    char name[64];
+    std::printf("--- %s, K = %zu, %zu elements\n", type, K, data.size());
+
+    std::snprintf(name, sizeof name, "inplace_top_k::offer(first, last)");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      lyn::inplace_top_k<T, K> top;
+                      top.offer(data.begin(), data.end());
+                      bench::do_not_optimize(top.sorted_drain());
+                  }),
+                  data.size());
+
+    std::snprintf(name, sizeof name, "inplace_top_k::offer(value)");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      lyn::inplace_top_k<T, K> top;
+                      for(auto& v : data) top.offer(v);
+                      bench::do_not_optimize(top.sorted_drain());
+                  }),
+                  data.size());
+
+    std::vector<T> work(data.size());
+    std::snprintf(name, sizeof name, "copy + std::partial_sort");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      std::copy(data.begin(), data.end(), work.begin());
+                      std::partial_sort(work.begin(), work.begin() + K, work.end(), std::greater<T>{});
+                      bench::do_not_optimize(work.front());
+                  }),
+                  data.size());
+
+    std::snprintf(name, sizeof name, "copy + std::nth_element + std::sort");
+    bench::report(name,
+                  bench::best_ns([&] {
+                      std::copy(data.begin(), data.end(), work.begin());
+                      std::nth_element(work.begin(), work.begin() + K, work.end(), std::greater<T>{});
+                      std::sort(work.begin(), work.begin() + K, std::greater<T>{});
+                      bench::do_not_optimize(work.front());
+                  }),
+                  data.size());
+}
+} // namespace
+
+int main() {
+    constexpr std::size_t count = 10'000'000;
+    bench::xorshift rng;
+    std::vector<float> floats(count);
+    for(auto& v : floats) v = static_cast<float>(rng() >> 40);
+    std::vector<int> ints(count);
+    for(auto& v : ints) v = static_cast<int>(rng() >> 33);
+
+    run<16>("float", floats);
+    run<100>("float", floats);
+    run<1000>("float", floats);
+    run<16>("int", ints);
+    run<100>("int", ints);
+    run<1000>("int", ints);
+}
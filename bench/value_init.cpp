@@ -0,0 +1,32 @@
+// Code generation check: value-initializing an empty inplace_vector must not fill its storage.
+// Built by 'make codegen' to assembly, which fails if it contains a call to memset or a rep stos.
+#include "inplace_vector.hpp"
+
+#include <optional>
+#include <string>
+
+void sink(const void*);
+
+void value_init_trivial() {
+    lyn::inplace_vector<int, 4096> v{};
+    sink(&v);
+}
+
+void value_init_non_trivial() {
+    lyn::inplace_vector<std::string, 512> v{};
+    sink(&v);
+}
+
+struct holder {
+    lyn::inplace_vector<double, 1024> m_buf{};
+    int m_id{};
+};
+
+void member_init() {
+    holder h;
+    sink(&h);
+}
+
+void optional_emplace(std::optional<lyn::inplace_vector<int, 4096>>& opt) {
+    opt.emplace();
+}
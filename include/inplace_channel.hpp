@@ -0,0 +1,245 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_6FA2202C_CB5B_11F1_931F_02FC00000001
+#define LYNIPV_6FA2202C_CB5B_11F1_931F_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+# include <coroutine>
+# include <cstddef>
+# include <new>
+# include <optional>
+# include <type_traits>
+# include <utility>
+
+namespace lyn {
+
+// A bounded channel between coroutines with N elements of buffer space in the object itself.
+//
+//     bool sent = co_await ch.send(value);          // false if the channel is closed
+//     std::optional<T> value = co_await ch.receive(); // std::nullopt once closed and drained
+//
+// send suspends while the buffer is full and receive while it is empty. A waiting coroutine is resumed
+// directly, from inside the operation on the other side that unblocks it, before that operation returns.
+// Waiting is done in the awaiters, which live in the coroutine frames, so no operation allocates.
+//
+// close() stops accepting sends. Receivers drain what is buffered and then get std::nullopt, and suspended
+// senders are resumed with false. cancel() also discards the buffered elements.
+//
+// The channel is not thread safe and must not be destroyed while a coroutine is suspended on it.
+template<class T, std::size_t N>
+class inplace_channel {
+    static_assert(N != 0, "inplace_channel: N must be greater than zero");
+    static_assert(std::is_nothrow_destructible<T>::value, "inplace_channel: classes with potentially throwing destructors are prohibited");
+
+    struct alignas(T) slot {
+        unsigned char data[sizeof(T)];
+    };
+
+    // a suspended awaiter, linked into the FIFO of its side of the channel
+    struct waiter {
+        waiter* prev = nullptr;
+        waiter* next = nullptr;
+        std::coroutine_handle<> handle;
+    };
+
+    struct waiter_list {
+        waiter* head = nullptr;
+        waiter* tail = nullptr;
+
+        bool empty() const noexcept { return head == nullptr; }
+        void push_back(waiter* node) noexcept {
+            node->prev = tail;
+            node->next = nullptr;
+            (tail ? tail->next : head) = node;
+            tail = node;
+        }
+        void unlink(waiter* node) noexcept {
+            (node->prev ? node->prev->next : head) = node->next;
+            (node->next ? node->next->prev : tail) = node->prev;
+            node->prev = node->next = nullptr;
+        }
+        bool linked(const waiter* node) const noexcept { return node->prev || head == node; }
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    class [[nodiscard]] send_awaiter : private waiter {
+    public:
+        send_awaiter(const send_awaiter&) = delete;
+        send_awaiter& operator=(const send_awaiter&) = delete;
+        ~send_awaiter() {
+            if(m_ch.m_senders.linked(this)) m_ch.m_senders.unlink(this);
+        }
+
+        bool await_ready() { return m_ch.m_closed || (m_sent = m_ch.try_send(std::move(m_value))); }
+        void await_suspend(std::coroutine_handle<> handle) noexcept {
+            this->handle = handle;
+            m_ch.m_senders.push_back(this);
+        }
+        // false if the value was not sent because the channel was closed
+        bool await_resume() const noexcept { return m_sent; }
+
+    private:
+        friend class inplace_channel;
+        template<class U>
+        send_awaiter(inplace_channel& ch, U&& value) : m_ch(ch), m_value(std::forward<U>(value)) {}
+
+        inplace_channel& m_ch;
+        T m_value;
+        bool m_sent = false;
+    };
+
+    class [[nodiscard]] receive_awaiter : private waiter {
+    public:
+        receive_awaiter(const receive_awaiter&) = delete;
+        receive_awaiter& operator=(const receive_awaiter&) = delete;
+        ~receive_awaiter() {
+            if(m_ch.m_receivers.linked(this)) m_ch.m_receivers.unlink(this);
+        }
+
+        bool await_ready() {
+            m_value = m_ch.try_receive();
+            return m_value || m_ch.m_closed;
+        }
+        void await_suspend(std::coroutine_handle<> handle) noexcept {
+            this->handle = handle;
+            m_ch.m_receivers.push_back(this);
+        }
+        // std::nullopt if the channel was closed
+        std::optional<T> await_resume() noexcept(std::is_nothrow_move_constructible<T>::value) { return std::move(m_value); }
+
+    private:
+        friend class inplace_channel;
+        explicit receive_awaiter(inplace_channel& ch) noexcept : m_ch(ch) {}
+
+        inplace_channel& m_ch;
+        std::optional<T> m_value;
+    };
+
+    inplace_channel() = default;
+    inplace_channel(const inplace_channel&) = delete;
+    inplace_channel& operator=(const inplace_channel&) = delete;
+    ~inplace_channel() { discard(); }
+
+    // awaitable operations
+    send_awaiter send(const T& value) { return send_awaiter(*this, value); }
+    send_awaiter send(T&& value) { return send_awaiter(*this, std::move(value)); }
+    receive_awaiter receive() noexcept { return receive_awaiter(*this); }
+
+    // Non-suspending operations. try_send fails if the channel is closed or full and value is then left
+    // untouched. try_receive returns std::nullopt if nothing is buffered.
+    bool try_send(const T& value) { return try_send_impl(value); }
+    bool try_send(T&& value) { return try_send_impl(std::move(value)); }
+    std::optional<T> try_receive() {
+        if(m_size == 0) return std::nullopt;
+        std::optional<T> rv(std::move(*ptr(m_head)));
+        ptr(m_head)->~T();
+        m_head = next(m_head);
+        --m_size;
+        if(!m_senders.empty()) {
+            // the buffer was full, so the first waiting sender gets its value in
+            auto sender = static_cast<send_awaiter*>(m_senders.head);
+            ::new(static_cast<void*>(m_slots[tail()].data)) T(std::move(sender->m_value));
+            ++m_size;
+            sender->m_sent = true;
+            m_senders.unlink(sender);
+            sender->handle.resume();
+        }
+        return rv;
+    }
+
+    void close() {
+        m_closed = true;
+        while(!m_receivers.empty()) resume_first(m_receivers);
+        while(!m_senders.empty()) resume_first(m_senders);
+    }
+    void cancel() {
+        discard();
+        close();
+    }
+
+    // observers
+    bool closed() const noexcept { return m_closed; }
+    bool empty() const noexcept { return m_size == 0; }
+    bool full() const noexcept { return m_size == N; }
+    size_type size() const noexcept { return m_size; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+private:
+    T* ptr(size_type idx) noexcept { return lyn_inplace_vector_detail::launder(reinterpret_cast<T*>(m_slots[idx].data)); }
+    static size_type next(size_type idx) noexcept { return idx + 1 == N ? 0 : idx + 1; }
+    size_type tail() const noexcept { return m_head + m_size < N ? m_head + m_size : m_head + m_size - N; }
+
+    template<class U>
+    bool try_send_impl(U&& value) {
+        if(m_closed) return false;
+        if(!m_receivers.empty()) {
+            // the buffer is empty, so hand the value to the first waiting receiver directly
+            auto receiver = static_cast<receive_awaiter*>(m_receivers.head);
+            receiver->m_value.emplace(std::forward<U>(value));
+            m_receivers.unlink(receiver);
+            receiver->handle.resume();
+            return true;
+        }
+        if(full()) return false;
+        ::new(static_cast<void*>(m_slots[tail()].data)) T(std::forward<U>(value));
+        ++m_size;
+        return true;
+    }
+
+    void resume_first(waiter_list& list) {
+        auto node = list.head;
+        list.unlink(node);
+        node->handle.resume();
+    }
+
+    void discard() noexcept {
+        for(; m_size; --m_size, m_head = next(m_head)) ptr(m_head)->~T();
+        m_head = 0;
+    }
+
+    slot m_slots[N];
+    size_type m_head = 0;
+    size_type m_size = 0;
+    waiter_list m_senders;
+    waiter_list m_receivers;
+    bool m_closed = false;
+};
+
+} // namespace lyn
+
+#endif
+
+#endif
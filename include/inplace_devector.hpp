@@ -0,0 +1,483 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_109C8A68_CB6A_11F1_BDDD_02FC00000001
+#define LYNIPV_109C8A68_CB6A_11F1_BDDD_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+namespace lyn_inplace_devector_detail {
+    // the smallest index type that can hold the positions 0 to N
+    template<std::size_t N>
+    using index_type = typename std::conditional<
+        (N <= 0xFFFF), std::uint16_t, typename std::conditional<(N <= 0xFFFFFFFF), std::uint32_t, std::size_t>::type>::type;
+} // namespace lyn_inplace_devector_detail
+
+// A vector with free space at both ends of its inline storage, so that push_front() and inserting a range at
+// the front cost the same as push_back() and appending. The elements stay contiguous, so data() and
+// std::span work like for inplace_vector.
+//
+// When the end that grows runs out of free space, the elements are moved so that the free space that is left
+// after the insertion is split evenly between the two ends. Growing at either end is therefore amortized O(1)
+// while the devector is well below full, but close to full every recentering moves all elements to make room
+// for only a few. recenter() places the elements explicitly, for example to leave room for the headers that
+// will be prepended to a payload, which costs nothing when the devector is empty. Inserting and erasing in the
+// middle moves the shorter side.
+//
+// Moving the elements invalidates all iterators, pointers and references, and it must not fail half way, so
+// T must be nothrow move constructible.
+template<class T, std::size_t N>
+class inplace_devector {
+    static_assert(N != 0, "inplace_devector: N must be greater than zero");
+    static_assert(!std::is_const<T>::value, "inplace_devector: T must not be const");
+    static_assert(std::is_nothrow_destructible<T>::value,
+                  "inplace_devector: classes with potentially throwing destructors are prohibited");
+    static_assert(std::is_nothrow_move_constructible<T>::value, "inplace_devector: T must be nothrow move constructible");
+
+    using index_type = lyn_inplace_devector_detail::index_type<N>;
+    struct alignas(T) slot {
+        unsigned char data[sizeof(T)];
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using iterator = T*;
+    using const_iterator = T const*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // constructors
+    inplace_devector() = default;
+    explicit inplace_devector(size_type count) : inplace_devector() { resize(count); }
+    inplace_devector(size_type count, const T& value) : inplace_devector() { resize(count, value); }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    inplace_devector(InputIt first, InputIt last) : inplace_devector() {
+        insert(end(), first, last);
+    }
+    inplace_devector(std::initializer_list<T> ilist) : inplace_devector(ilist.begin(), ilist.end()) {}
+
+    // copies and moves keep the free space at the front of other
+    inplace_devector(const inplace_devector& other) : inplace_devector() {
+        m_begin = m_end = other.m_begin;
+        for(auto& value : other) unchecked_emplace_back(value);
+    }
+    inplace_devector(inplace_devector&& other) noexcept : inplace_devector() {
+        m_begin = m_end = other.m_begin;
+        for(auto& value : other) unchecked_emplace_back(std::move(value));
+        other.clear();
+    }
+    ~inplace_devector() { clear(); }
+
+    // assignment
+    inplace_devector& operator=(const inplace_devector& other) {
+        if(this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    inplace_devector& operator=(inplace_devector&& other) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        if(this != &other) {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        return *this;
+    }
+    inplace_devector& operator=(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // assigns over the existing elements before constructing or destroying any
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void assign(InputIt first, InputIt last) {
+        auto it = begin();
+        for(; it != end() && first != last; ++it, ++first) *it = *first;
+        if(it != end()) {
+            erase(it, end());
+        } else {
+            insert(end(), first, last);
+        }
+    }
+    void assign(size_type count, const T& value) {
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        auto it = begin();
+        for(; it != end() && count; ++it, --count) *it = value;
+        if(it != end()) {
+            erase(it, end());
+        } else {
+            insert(end(), count, value);
+        }
+    }
+    void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    // element access
+    reference at(size_type idx) {
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
+        return begin()[idx];
+    }
+    const_reference at(size_type idx) const {
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
+        return begin()[idx];
+    }
+    reference operator[](size_type idx) noexcept { return begin()[idx]; }
+    const_reference operator[](size_type idx) const noexcept { return begin()[idx]; }
+    reference front() noexcept { return *begin(); }
+    const_reference front() const noexcept { return *begin(); }
+    reference back() noexcept { return end()[-1]; }
+    const_reference back() const noexcept { return end()[-1]; }
+    pointer data() noexcept { return begin(); }
+    const_pointer data() const noexcept { return begin(); }
+
+    // iterators
+    iterator begin() noexcept { return ptr(m_begin); }
+    iterator end() noexcept { return ptr(m_end); }
+    const_iterator begin() const noexcept { return ptr(m_begin); }
+    const_iterator end() const noexcept { return ptr(m_end); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // size and capacity
+    bool empty() const noexcept { return m_begin == m_end; }
+    bool full() const noexcept { return size() == N; }
+    size_type size() const noexcept { return static_cast<size_type>(m_end - m_begin); }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+    size_type front_free_capacity() const noexcept { return m_begin; }
+    size_type back_free_capacity() const noexcept { return N - m_end; }
+    static void reserve(size_type new_cap) {
+        if(new_cap > N) lyn_inplace_vector_detail::throw_bad_alloc();
+    }
+    static void shrink_to_fit() noexcept {}
+    void resize(size_type count) {
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        if(count <= size()) {
+            destroy_back(size() - count);
+            return;
+        }
+        const auto added = count - size();
+        make_room(false, added);
+        insert_constructed(size(), false, added, [added](T* where) {
+            constructed_range constructed{where, where};
+            for(; constructed.last != where + added; ++constructed.last) ::new(static_cast<void*>(constructed.last)) T();
+            constructed.first = constructed.last;
+        });
+    }
+    void resize(size_type count, const T& value) {
+        if(count <= size()) {
+            destroy_back(size() - count);
+        } else {
+            insert(end(), count - size(), value);
+        }
+    }
+
+    // Moves the elements so that front_free slots are free before them. Throws std::bad_alloc if there are
+    // not that many free slots.
+    void recenter(size_type front_free) {
+        if(front_free > N - size()) lyn_inplace_vector_detail::throw_bad_alloc();
+        move_to(front_free);
+    }
+    // moves the elements so that the free space is split evenly between the two ends
+    void recenter() noexcept { move_to((N - size()) / 2); }
+
+    // modifiers
+    void clear() noexcept { destroy_back(size()); }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        if(full()) lyn_inplace_vector_detail::throw_bad_alloc();
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    reference emplace_front(Args&&... args) {
+        if(full()) lyn_inplace_vector_detail::throw_bad_alloc();
+        return unchecked_emplace_front(std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    pointer try_emplace_back(Args&&... args) {
+        if(full()) return nullptr;
+        return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+    }
+    template<class... Args>
+    pointer try_emplace_front(Args&&... args) {
+        if(full()) return nullptr;
+        return std::addressof(unchecked_emplace_front(std::forward<Args>(args)...));
+    }
+    // Precondition: !full(). When the end is reached, the new element is constructed before the elements move,
+    // since args may refer to one of them.
+    template<class... Args>
+    reference unchecked_emplace_back(Args&&... args) {
+        if(m_end == N) {
+            T value(std::forward<Args>(args)...);
+            make_room(false, 1);
+            return construct_back(std::move(value));
+        }
+        return construct_back(std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    reference unchecked_emplace_front(Args&&... args) {
+        if(m_begin == 0) {
+            T value(std::forward<Args>(args)...);
+            make_room(true, 1);
+            return construct_front(std::move(value));
+        }
+        return construct_front(std::forward<Args>(args)...);
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+    pointer try_push_back(const T& value) { return try_emplace_back(value); }
+    pointer try_push_back(T&& value) { return try_emplace_back(std::move(value)); }
+    pointer try_push_front(const T& value) { return try_emplace_front(value); }
+    pointer try_push_front(T&& value) { return try_emplace_front(std::move(value)); }
+    void pop_back() noexcept { destroy_back(1); }
+    void pop_front() noexcept { destroy_front(1); }
+
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        if(full()) lyn_inplace_vector_detail::throw_bad_alloc();
+        const auto off = offset(pos);
+        if(off < size() - off) {
+            unchecked_emplace_front(std::forward<Args>(args)...);
+            std::rotate(begin(), begin() + 1, begin() + 1 + off);
+        } else {
+            unchecked_emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + off, end() - 1, end());
+        }
+        return begin() + off;
+    }
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        if(count > N - size()) lyn_inplace_vector_detail::throw_bad_alloc();
+        const auto off = offset(pos);
+        const bool at_front = off < size() - off;
+        const auto fill = [count](const T& src) {
+            return [count, &src](T* where) { std::uninitialized_fill_n(where, count, src); };
+        };
+        if(count > (at_front ? front_free_capacity() : back_free_capacity())) {
+            const T copy(value); // value may be one of the elements that are about to move
+            make_room(at_front, count);
+            return insert_constructed(off, at_front, count, fill(copy));
+        }
+        return insert_constructed(off, at_front, count, fill(value));
+    }
+    // Precondition: [first, last) is not a range in *this.
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        return insert_range(offset(pos), first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+    }
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto off = offset(first);
+        const auto count = static_cast<size_type>(last - first);
+        if(count == 0) return begin() + off;
+        if(off < size() - off - count) {
+            std::move_backward(begin(), begin() + off, begin() + off + count);
+            destroy_front(count);
+        } else {
+            std::move(begin() + off + count, end(), begin() + off);
+            destroy_back(count);
+        }
+        return begin() + off;
+    }
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    void swap(inplace_devector& other) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        inplace_devector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+    friend void swap(inplace_devector& lhs, inplace_devector& rhs) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const inplace_devector& lhs, const inplace_devector& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator!=(const inplace_devector& lhs, const inplace_devector& rhs) { return !(lhs == rhs); }
+    friend bool operator<(const inplace_devector& lhs, const inplace_devector& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    friend bool operator>(const inplace_devector& lhs, const inplace_devector& rhs) { return rhs < lhs; }
+    friend bool operator<=(const inplace_devector& lhs, const inplace_devector& rhs) { return !(rhs < lhs); }
+    friend bool operator>=(const inplace_devector& lhs, const inplace_devector& rhs) { return !(lhs < rhs); }
+
+private:
+    // destroys the elements constructed in [first, last) unless the devector adopts them and empties the range
+    struct constructed_range {
+        T* first;
+        T* last;
+        ~constructed_range() {
+            for(; first != last; ++first) first->~T();
+        }
+    };
+
+    T* ptr(size_type idx) noexcept { return lyn_inplace_vector_detail::launder(reinterpret_cast<T*>(m_slots[0].data)) + idx; }
+    const T* ptr(size_type idx) const noexcept {
+        return lyn_inplace_vector_detail::launder(reinterpret_cast<const T*>(m_slots[0].data)) + idx;
+    }
+    size_type offset(const_iterator pos) const noexcept { return static_cast<size_type>(pos - cbegin()); }
+
+    template<class... Args>
+    reference construct_back(Args&&... args) {
+        T* elem = ::new(static_cast<void*>(ptr(m_end))) T(std::forward<Args>(args)...);
+        ++m_end;
+        return *elem;
+    }
+    template<class... Args>
+    reference construct_front(Args&&... args) {
+        T* elem = ::new(static_cast<void*>(ptr(m_begin - 1u))) T(std::forward<Args>(args)...);
+        --m_begin;
+        return *elem;
+    }
+    void destroy_back(size_type count) noexcept {
+        if(!std::is_trivially_destructible<T>::value) std::for_each(end() - count, end(), [](T& elem) { elem.~T(); });
+        m_end = static_cast<index_type>(m_end - count);
+    }
+    void destroy_front(size_type count) noexcept {
+        if(!std::is_trivially_destructible<T>::value) std::for_each(begin(), begin() + count, [](T& elem) { elem.~T(); });
+        m_begin = static_cast<index_type>(m_begin + count);
+    }
+
+    // Makes room for count more elements at one end, which must fit in the devector, by moving the elements
+    // so that the free space that will be left is split evenly between the two ends.
+    void make_room(bool at_front, size_type count) noexcept {
+        if(count <= (at_front ? front_free_capacity() : back_free_capacity())) return;
+        const auto spare = N - size() - count;
+        move_to(spare / 2 + (at_front ? count : 0));
+    }
+    void move_to(size_type new_begin) noexcept {
+        if(new_begin == m_begin) return;
+        const auto count = size();
+        relocate(ptr(new_begin), begin(), end(), std::integral_constant<bool, is_trivially_relocatable<T>::value>{});
+        m_begin = static_cast<index_type>(new_begin);
+        m_end = static_cast<index_type>(new_begin + count);
+    }
+    static void relocate(T* dst, T* first, T* last, std::true_type) noexcept {
+        if(first != last) {
+            const auto bytes = static_cast<std::size_t>(last - first) * sizeof(T);
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(first), bytes);
+        }
+    }
+    // the ranges may overlap, so the element that is moved first is the one nearest to dst
+    static void relocate(T* dst, T* first, T* last, std::false_type) noexcept {
+        if(dst < first) {
+            for(; first != last; ++first, ++dst) {
+                ::new(static_cast<void*>(dst)) T(std::move(*first));
+                first->~T();
+            }
+        } else {
+            for(dst += last - first; first != last;) {
+                ::new(static_cast<void*>(--dst)) T(std::move(*--last));
+                last->~T();
+            }
+        }
+    }
+
+    // Constructs count elements with construct(where), which constructs all of them or none, in the free space at
+    // one end, where there must be room for them, and rotates them into place at off.
+    template<class Construct>
+    iterator insert_constructed(size_type off, bool at_front, size_type count, Construct construct) {
+        const auto first = at_front ? m_begin - count : size_type(m_end);
+        construct(ptr(first));
+        if(at_front) {
+            m_begin = static_cast<index_type>(first);
+            std::rotate(begin(), begin() + count, begin() + count + off);
+        } else {
+            m_end = static_cast<index_type>(first + count);
+            std::rotate(begin() + off, end() - count, end());
+        }
+        return begin() + off;
+    }
+    template<class ForwardIt>
+    iterator insert_range(size_type off, ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+        const auto count = static_cast<size_type>(std::distance(first, last));
+        if(count > N - size()) lyn_inplace_vector_detail::throw_bad_alloc();
+        const bool at_front = off < size() - off;
+        make_room(at_front, count);
+        return insert_constructed(off, at_front, count,
+                                  [count, &first](T* where) { std::uninitialized_copy_n(first, count, where); });
+    }
+    // a single pass range is collected first, to know how much room to make
+    template<class InputIt>
+    iterator insert_range(size_type off, InputIt first, InputIt last, std::input_iterator_tag) {
+        inplace_devector collected;
+        for(; first != last; ++first) collected.emplace_back(*first);
+        return insert_range(off, std::make_move_iterator(collected.begin()), std::make_move_iterator(collected.end()),
+                            std::random_access_iterator_tag{});
+    }
+
+    slot m_slots[N];           // [m_begin, m_end) holds the elements, the rest is uninitialized
+    index_type m_begin = 0;
+    index_type m_end = 0;
+};
+
+template<class T, std::size_t N, class U>
+typename inplace_devector<T, N>::size_type erase(inplace_devector<T, N>& c, const U& value) {
+    const auto it = std::remove(c.begin(), c.end(), value);
+    const auto count = static_cast<typename inplace_devector<T, N>::size_type>(c.end() - it);
+    c.erase(it, c.end());
+    return count;
+}
+template<class T, std::size_t N, class Pred>
+typename inplace_devector<T, N>::size_type erase_if(inplace_devector<T, N>& c, Pred pred) {
+    const auto it = std::remove_if(c.begin(), c.end(), pred);
+    const auto count = static_cast<typename inplace_devector<T, N>::size_type>(c.end() - it);
+    c.erase(it, c.end());
+    return count;
+}
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,212 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_0669F54A_CB64_11F1_BB50_02FC00000001
+#define LYNIPV_0669F54A_CB64_11F1_BB50_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+namespace lyn_inplace_eytzinger_detail {
+    // The address is formed as an integer since the descendants of the deepest nodes are outside the keys.
+    // Prefetching an address that is not mapped is harmless.
+    inline void prefetch(const void* base, std::size_t offset) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(base) + offset));
+#else
+        static_cast<void>(base);
+        static_cast<void>(offset);
+#endif
+    }
+
+    // the largest power of two that is not greater than value, 1 if value is 0
+    constexpr std::size_t floor_pow2(std::size_t value, std::size_t pow = 1) {
+        return pow * 2 <= value ? floor_pow2(value, pow * 2) : pow;
+    }
+} // namespace lyn_inplace_eytzinger_detail
+
+// A static search index over at most N keys, built once from keys that are sorted according to Compare.
+// The keys are stored in breadth first (Eytzinger) order, so that the first levels of every search share
+// a few cache lines and the descendants a few levels down are adjacent and can be prefetched while the
+// search is still comparing. The descent has no branch on the outcome of the comparisons. Every stored
+// key also remembers its position in the sorted input, which is what rank() returns.
+template<class Key, std::size_t N, class Compare = std::less<Key>>
+class inplace_eytzinger {
+    static_assert(N != 0, "inplace_eytzinger: N must be greater than zero");
+    static_assert(N < 0xFFFFFFFF, "inplace_eytzinger: N is too large");
+
+    using rank_type = typename std::conditional<(N <= 0xFFFF), std::uint16_t, std::uint32_t>::type;
+
+    // The 2^levels descendants that are `levels` below a node are adjacent, so the search prefetches that
+    // many levels ahead when a cache line holds 2^levels keys. Keys larger than half a cache line are not
+    // prefetched.
+    static constexpr std::size_t prefetch_stride =
+        lyn_inplace_eytzinger_detail::floor_pow2(lyn_inplace_vector_detail::cache_line / sizeof(Key));
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = const Key&;
+    using sorted_type = inplace_vector<Key, N>;
+    using const_iterator = typename sorted_type::const_iterator;
+
+    inplace_eytzinger() = default;
+    explicit inplace_eytzinger(const Compare& comp) : m_comp(comp) {}
+
+    // Precondition for all of these: the keys are sorted according to comp. Equal keys are allowed.
+    explicit inplace_eytzinger(const sorted_type& sorted, const Compare& comp = Compare()) : m_comp(comp) {
+        build(sorted.begin(), sorted.size());
+    }
+    explicit inplace_eytzinger(sorted_type&& sorted, const Compare& comp = Compare()) : m_comp(comp) {
+        build(std::make_move_iterator(sorted.begin()), sorted.size());
+    }
+    template<class InputIt>
+    inplace_eytzinger(InputIt first, InputIt last, const Compare& comp = Compare()) : m_comp(comp) {
+        build_range(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+    }
+
+    // capacity
+    bool empty() const noexcept { return m_keys.empty(); }
+    size_type size() const noexcept { return m_keys.size(); }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // the keys in layout order, which is not the sorted order
+    const_iterator begin() const noexcept { return m_keys.begin(); }
+    const_iterator end() const noexcept { return m_keys.end(); }
+
+    key_compare key_comp() const { return m_comp; }
+
+    // the first key, in sorted order, that is not less than key, or end()
+    const_iterator lower_bound(const Key& key) const {
+        const size_type node = descend(key);
+        return begin() + static_cast<difference_type>(node ? node - 1 : size());
+    }
+
+    bool contains(const Key& key) const {
+        const auto it = lower_bound(key);
+        return it != end() && !m_comp(key, *it);
+    }
+
+    // the position in the sorted input of the key at it, or size() for end()
+    size_type rank(const_iterator it) const noexcept {
+        return it == end() ? size() : m_rank[static_cast<size_type>(it - begin())];
+    }
+
+    // the number of keys less than key, which is where std::lower_bound on the sorted input would end up
+    size_type rank(const Key& key) const { return rank(lower_bound(key)); }
+
+    // the keys in sorted order
+    sorted_type sorted() const {
+        sorted_type rv;
+        const size_type count = size();
+        if(count == 0) return rv;
+        size_type node = 1;
+        while(2 * node <= count) node *= 2;
+        for(;;) {
+            rv.unchecked_push_back(m_keys[node - 1]);
+            if(2 * node + 1 <= count) {
+                // the leftmost node of the right subtree
+                for(node = 2 * node + 1; 2 * node <= count;) node *= 2;
+            } else {
+                // up past the nodes whose right subtree is done
+                node >>= lyn_inplace_vector_detail::countr_one(node) + 1;
+                if(node == 0) break;
+            }
+        }
+        return rv;
+    }
+
+private:
+    // The search goes left or right without branching and ends below a leaf. The path taken is then the
+    // bits of the returned node: every right turn shifted in a 1, so the node where the search last went
+    // left, which is the lower bound, is found by dropping the trailing ones and one more bit. A search
+    // that only went right ends at 0. Nodes are numbered from 1.
+    size_type descend(const Key& key) const {
+        const size_type count = size();
+        const Key* keys = m_keys.data();
+        size_type node = 1;
+        while(node <= count) {
+            if(prefetch_stride > 1) {
+                lyn_inplace_eytzinger_detail::prefetch(keys, (node * prefetch_stride - 1) * sizeof(Key));
+            }
+            node = 2 * node + static_cast<size_type>(m_comp(keys[node - 1], key));
+        }
+        return node >> (lyn_inplace_vector_detail::countr_one(node) + 1);
+    }
+
+    // an in-order walk of the tree hands out the sorted positions
+    void assign_ranks(size_type node, size_type& next) {
+        if(node > m_rank.size()) return;
+        assign_ranks(2 * node, next);
+        m_rank[node - 1] = static_cast<rank_type>(next++);
+        assign_ranks(2 * node + 1, next);
+    }
+
+    template<class RandomIt>
+    void build(RandomIt sorted, size_type count) {
+        m_rank.resize(count);
+        size_type next = 0;
+        assign_ranks(1, next);
+        for(size_type idx = 0; idx != count; ++idx) {
+            m_keys.unchecked_push_back(sorted[static_cast<difference_type>(m_rank[idx])]);
+        }
+    }
+
+    template<class RandomIt>
+    void build_range(RandomIt first, RandomIt last, std::random_access_iterator_tag) {
+        const auto count = static_cast<size_type>(std::distance(first, last));
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        build(first, count);
+    }
+
+    template<class InputIt>
+    void build_range(InputIt first, InputIt last, std::input_iterator_tag) {
+        sorted_type sorted(first, last);
+        build(std::make_move_iterator(sorted.begin()), sorted.size());
+    }
+
+    inplace_vector<Key, N> m_keys;
+    inplace_vector<rank_type, N> m_rank;
+    Compare m_comp;
+};
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,384 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_25DDA2B0_CB59_11F1_9B64_02FC00000001
+#define LYNIPV_25DDA2B0_CB59_11F1_9B64_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+namespace lyn_inplace_list_detail {
+    // the smallest index type that can address N slots and the sentinel at index N
+    template<std::size_t N>
+    using index_type = typename std::conditional<(N < 0xFFFF), std::uint16_t, std::uint32_t>::type;
+} // namespace lyn_inplace_list_detail
+
+// A doubly linked list where the nodes live in N slots in the object itself and are linked by index.
+// Elements never move while they are in the list, so iterators, pointers and references stay valid until
+// the element is erased. Freed slots are reused through a free list.
+template<class T, std::size_t N>
+class inplace_list {
+    static_assert(N != 0, "inplace_list: N must be greater than zero");
+    static_assert(N < 0xFFFFFFFF, "inplace_list: N is too large");
+    static_assert(std::is_nothrow_destructible<T>::value, "inplace_list: classes with potentially throwing destructors are prohibited");
+
+    using index_type = lyn_inplace_list_detail::index_type<N>;
+    static constexpr index_type sentinel = static_cast<index_type>(N);
+
+    struct link {
+        index_type prev;
+        index_type next;
+    };
+    struct alignas(T) slot {
+        unsigned char data[sizeof(T)];
+    };
+
+    template<bool Const>
+    class basic_iterator {
+        using list_ptr = typename std::conditional<Const, const inplace_list*, inplace_list*>::type;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T*, T*>::type;
+        using reference = typename std::conditional<Const, const T&, T&>::type;
+
+        basic_iterator() = default;
+        template<bool C = Const, typename std::enable_if<C, int>::type = 0>
+        basic_iterator(const basic_iterator<false>& other) noexcept : m_list(other.m_list), m_idx(other.m_idx) {}
+
+        reference operator*() const noexcept { return *m_list->ptr(m_idx); }
+        pointer operator->() const noexcept { return m_list->ptr(m_idx); }
+
+        basic_iterator& operator++() noexcept {
+            m_idx = m_list->m_links[m_idx].next;
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto rv = *this;
+            ++*this;
+            return rv;
+        }
+        basic_iterator& operator--() noexcept {
+            m_idx = m_list->m_links[m_idx].prev;
+            return *this;
+        }
+        basic_iterator operator--(int) noexcept {
+            auto rv = *this;
+            --*this;
+            return rv;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx == rhs.m_idx; }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx != rhs.m_idx; }
+
+    private:
+        friend class inplace_list;
+        template<bool>
+        friend class basic_iterator;
+        basic_iterator(list_ptr list, index_type idx) noexcept : m_list(list), m_idx(idx) {}
+
+        list_ptr m_list = nullptr;
+        index_type m_idx = 0;
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // constructors
+    inplace_list() noexcept { m_links[sentinel] = link{sentinel, sentinel}; }
+    explicit inplace_list(size_type count) : inplace_list() {
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        while(count--) unchecked_emplace(end());
+    }
+    inplace_list(size_type count, const T& value) : inplace_list() { insert(end(), count, value); }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    inplace_list(InputIt first, InputIt last) : inplace_list() {
+        insert(end(), first, last);
+    }
+    inplace_list(std::initializer_list<T> ilist) : inplace_list(ilist.begin(), ilist.end()) {}
+
+    inplace_list(const inplace_list& other) : inplace_list(other.begin(), other.end()) {}
+    inplace_list(inplace_list&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : inplace_list() {
+        for(auto& value : other) unchecked_emplace(end(), std::move(value));
+        other.clear();
+    }
+    ~inplace_list() { clear(); }
+
+    // assignment
+    inplace_list& operator=(const inplace_list& other) {
+        if(this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    inplace_list& operator=(inplace_list&& other) noexcept(std::is_nothrow_move_assignable<T>::value &&
+                                                           std::is_nothrow_move_constructible<T>::value) {
+        if(this != &other) {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        return *this;
+    }
+    inplace_list& operator=(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // assigns over the existing elements before constructing or destroying any
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void assign(InputIt first, InputIt last) {
+        auto it = begin();
+        for(; it != end() && first != last; ++it, ++first) *it = *first;
+        if(it != end()) {
+            erase(it, end());
+        } else {
+            insert(end(), first, last);
+        }
+    }
+    void assign(size_type count, const T& value) {
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        auto it = begin();
+        for(; it != end() && count; ++it, --count) *it = value;
+        if(it != end()) {
+            erase(it, end());
+        } else {
+            insert(end(), count, value);
+        }
+    }
+    void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    // element access
+    reference front() noexcept { return *ptr(m_links[sentinel].next); }
+    const_reference front() const noexcept { return *ptr(m_links[sentinel].next); }
+    reference back() noexcept { return *ptr(m_links[sentinel].prev); }
+    const_reference back() const noexcept { return *ptr(m_links[sentinel].prev); }
+
+    // iterators
+    iterator begin() noexcept { return iterator(this, m_links[sentinel].next); }
+    iterator end() noexcept { return iterator(this, sentinel); }
+    const_iterator begin() const noexcept { return const_iterator(this, m_links[sentinel].next); }
+    const_iterator end() const noexcept { return const_iterator(this, sentinel); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // size and capacity
+    bool empty() const noexcept { return m_size == 0; }
+    bool full() const noexcept { return m_size == N; }
+    size_type size() const noexcept { return m_size; }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // modifiers
+    void clear() noexcept {
+        for(auto idx = m_links[sentinel].next; idx != sentinel; idx = m_links[idx].next) ptr(idx)->~T();
+        m_links[sentinel] = link{sentinel, sentinel};
+        m_free = sentinel;
+        m_unused = 0;
+        m_size = 0;
+    }
+
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        if(full()) lyn_inplace_vector_detail::throw_bad_alloc();
+        return unchecked_emplace(pos, std::forward<Args>(args)...);
+    }
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        if(count > N - m_size) lyn_inplace_vector_detail::throw_bad_alloc();
+        iterator first(this, pos.m_idx);
+        for(bool is_first = true; count; --count, is_first = false) {
+            auto it = unchecked_emplace(pos, value);
+            if(is_first) first = it;
+        }
+        return first;
+    }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        iterator rv(this, pos.m_idx);
+        for(bool is_first = true; first != last; ++first, is_first = false) {
+            auto it = emplace(pos, *first);
+            if(is_first) rv = it;
+        }
+        return rv;
+    }
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    reference emplace_front(Args&&... args) {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    pointer try_emplace_back(Args&&... args) {
+        if(full()) return nullptr;
+        return std::addressof(*unchecked_emplace(end(), std::forward<Args>(args)...));
+    }
+    template<class... Args>
+    pointer try_emplace_front(Args&&... args) {
+        if(full()) return nullptr;
+        return std::addressof(*unchecked_emplace(begin(), std::forward<Args>(args)...));
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+    void pop_back() noexcept { erase(const_iterator(this, m_links[sentinel].prev)); }
+    void pop_front() noexcept { erase(const_iterator(this, m_links[sentinel].next)); }
+
+    iterator erase(const_iterator pos) noexcept {
+        const auto idx = pos.m_idx;
+        const auto next = m_links[idx].next;
+        unlink(idx);
+        ptr(idx)->~T();
+        release(idx);
+        return iterator(this, next);
+    }
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        while(first != last) first = erase(first);
+        return iterator(this, last.m_idx);
+    }
+
+    // Moves [first, last) from other to before pos. Within the same list, the range is relinked in O(1).
+    // Between lists, the elements are moved into free slots here, so iterators to them are not preserved.
+    void splice(const_iterator pos, inplace_list& other, const_iterator first, const_iterator last) {
+        if(first == last) return;
+        if(&other == this) {
+            const auto head = first.m_idx;
+            const auto tail = m_links[last.m_idx].prev;
+            const auto before = m_links[head].prev;
+            m_links[before].next = last.m_idx;
+            m_links[last.m_idx].prev = before;
+            link_range(pos.m_idx, head, tail);
+            return;
+        }
+        if(static_cast<size_type>(std::distance(first, last)) > N - m_size) lyn_inplace_vector_detail::throw_bad_alloc();
+        while(first != last) {
+            unchecked_emplace(pos, std::move(*other.ptr(first.m_idx)));
+            first = other.erase(first);
+        }
+    }
+    void splice(const_iterator pos, inplace_list& other, const_iterator it) { splice(pos, other, it, std::next(it)); }
+    void splice(const_iterator pos, inplace_list& other) { splice(pos, other, other.begin(), other.end()); }
+
+    void swap(inplace_list& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        inplace_list tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+    friend void swap(inplace_list& lhs, inplace_list& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const inplace_list& lhs, const inplace_list& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator!=(const inplace_list& lhs, const inplace_list& rhs) { return !(lhs == rhs); }
+
+private:
+    T* ptr(index_type idx) noexcept { return lyn_inplace_vector_detail::launder(reinterpret_cast<T*>(m_slots[idx].data)); }
+    const T* ptr(index_type idx) const noexcept { return lyn_inplace_vector_detail::launder(reinterpret_cast<const T*>(m_slots[idx].data)); }
+
+    void release(index_type idx) noexcept {
+        m_links[idx].next = m_free;
+        m_free = idx;
+        --m_size;
+    }
+
+    // links the chain head..tail in before pos
+    void link_range(index_type pos, index_type head, index_type tail) noexcept {
+        const auto before = m_links[pos].prev;
+        m_links[before].next = head;
+        m_links[head].prev = before;
+        m_links[tail].next = pos;
+        m_links[pos].prev = tail;
+    }
+    void unlink(index_type idx) noexcept {
+        m_links[m_links[idx].prev].next = m_links[idx].next;
+        m_links[m_links[idx].next].prev = m_links[idx].prev;
+    }
+
+    // The slot is taken from the free list only after T has been constructed in it, so that nothing
+    // needs to be undone if the constructor throws.
+    template<class... Args>
+    iterator unchecked_emplace(const_iterator pos, Args&&... args) {
+        const auto idx = m_free != sentinel ? m_free : m_unused;
+        ::new(static_cast<void*>(m_slots[idx].data)) T(std::forward<Args>(args)...);
+        if(idx == m_free) {
+            m_free = m_links[idx].next;
+        } else {
+            ++m_unused;
+        }
+        link_range(pos.m_idx, idx, idx);
+        ++m_size;
+        return iterator(this, idx);
+    }
+
+    link m_links[N + 1];          // m_links[N] is the sentinel, linking the last and the first element
+    slot m_slots[N];              // uninitialized until an element is constructed in it
+    index_type m_free = sentinel; // first free slot that has been used before, linked through next
+    index_type m_unused = 0;      // the slots from here on have never been used
+    index_type m_size = 0;
+};
+
+template<class T, std::size_t N>
+constexpr typename inplace_list<T, N>::index_type inplace_list<T, N>::sentinel;
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,456 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_E6BD93F4_CB64_11F1_BACF_02FC00000001
+#define LYNIPV_E6BD93F4_CB64_11F1_BACF_02FC00000001
+
+#include "inplace_unordered_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+// A least recently used cache of at most N entries, stored in the object itself. The entries live in N
+// slots linked by index in recency order, and an open addressing index of slot numbers, probed like
+// inplace_unordered_map, finds them by key. Nothing allocates: a hit relinks the entry at the front, and
+// inserting into a full cache reuses the slot of the least recently used entry.
+//
+// Entries never move while they are in the cache, so pointers and references to an entry stay valid until
+// it is evicted or erased. Iteration goes from the most to the least recently used entry, and iterators
+// are invalidated when the order changes, which lookups through get() do.
+template<class Key, class T, std::size_t N, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class inplace_lru_cache {
+    static_assert(N != 0, "inplace_lru_cache: N must be greater than zero");
+    static_assert(N < 0xFFFFFFFF, "inplace_lru_cache: N is too large");
+    static_assert(std::is_nothrow_destructible<Key>::value && std::is_nothrow_destructible<T>::value,
+                  "inplace_lru_cache: classes with potentially throwing destructors are prohibited");
+    static_assert(std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<T>::value,
+                  "inplace_lru_cache: Key and T must be nothrow move constructible");
+
+    using index_type = typename std::conditional<(N < 0xFFFF), std::uint16_t, std::uint32_t>::type;
+    static constexpr index_type sentinel = static_cast<index_type>(N);
+    static constexpr std::size_t buckets = lyn_inplace_unordered_map_detail::bucket_count(N);
+    static constexpr std::size_t mask = buckets - 1;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    struct link {
+        index_type prev;
+        index_type next;
+    };
+    using node = lyn_inplace_unordered_map_detail::node<Key, T>;
+
+    template<bool Const>
+    class basic_iterator {
+        using cache_ptr = typename std::conditional<Const, const inplace_lru_cache*, inplace_lru_cache*>::type;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename inplace_lru_cache::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const value_type*, value_type*>::type;
+        using reference = typename std::conditional<Const, const value_type&, value_type&>::type;
+
+        basic_iterator() = default;
+        template<bool C = Const, typename std::enable_if<C, int>::type = 0>
+        basic_iterator(const basic_iterator<false>& other) noexcept : m_cache(other.m_cache), m_idx(other.m_idx) {}
+
+        reference operator*() const noexcept { return *m_cache->ptr(m_idx); }
+        pointer operator->() const noexcept { return m_cache->ptr(m_idx); }
+
+        basic_iterator& operator++() noexcept {
+            m_idx = m_cache->m_links[m_idx].next;
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto rv = *this;
+            ++*this;
+            return rv;
+        }
+        basic_iterator& operator--() noexcept {
+            m_idx = m_cache->m_links[m_idx].prev;
+            return *this;
+        }
+        basic_iterator operator--(int) noexcept {
+            auto rv = *this;
+            --*this;
+            return rv;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx == rhs.m_idx; }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx != rhs.m_idx; }
+
+    private:
+        friend class inplace_lru_cache;
+        template<bool>
+        friend class basic_iterator;
+        basic_iterator(cache_ptr cache, index_type idx) noexcept : m_cache(cache), m_idx(idx) {}
+
+        cache_ptr m_cache = nullptr;
+        index_type m_idx = sentinel;
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // constructors
+    inplace_lru_cache() : inplace_lru_cache(Hash(), KeyEqual()) {}
+    explicit inplace_lru_cache(const Hash& hash, const KeyEqual& equal = KeyEqual()) : m_hash(hash), m_equal(equal) {
+        std::memset(m_ctrl, lyn_inplace_unordered_map_detail::empty_ctrl, sizeof m_ctrl);
+        m_links[sentinel] = link{sentinel, sentinel};
+    }
+
+    // Copies and moves insert the entries of other from the least recently used, which reproduces its order.
+    inplace_lru_cache(const inplace_lru_cache& other) : inplace_lru_cache(other.m_hash, other.m_equal) { copy_from(other); }
+    inplace_lru_cache(inplace_lru_cache&& other) noexcept(std::is_nothrow_copy_constructible<Hash>::value &&
+                                                         std::is_nothrow_copy_constructible<KeyEqual>::value) :
+        inplace_lru_cache(other.m_hash, other.m_equal) {
+        copy_from(other);
+        other.clear();
+    }
+    ~inplace_lru_cache() { clear(); }
+
+    // assignment
+    inplace_lru_cache& operator=(const inplace_lru_cache& other) {
+        if(this != &other) {
+            clear();
+            m_hash = other.m_hash;
+            m_equal = other.m_equal;
+            copy_from(other);
+        }
+        return *this;
+    }
+    inplace_lru_cache& operator=(inplace_lru_cache&& other) noexcept(std::is_nothrow_copy_assignable<Hash>::value &&
+                                                                    std::is_nothrow_copy_assignable<KeyEqual>::value) {
+        if(this != &other) {
+            clear();
+            m_hash = other.m_hash;
+            m_equal = other.m_equal;
+            copy_from(other);
+            other.clear();
+        }
+        return *this;
+    }
+
+    // iterators, from the most recently used entry
+    iterator begin() noexcept { return iterator(this, m_links[sentinel].next); }
+    iterator end() noexcept { return iterator(this, sentinel); }
+    const_iterator begin() const noexcept { return const_iterator(this, m_links[sentinel].next); }
+    const_iterator end() const noexcept { return const_iterator(this, sentinel); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // capacity
+    bool empty() const noexcept { return m_size == 0; }
+    bool full() const noexcept { return m_size == N; }
+    size_type size() const noexcept { return m_size; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // lookup
+
+    // Returns the value for key and makes it the most recently used entry, or nullptr if key is not cached.
+    T* get(const Key& key) {
+        const auto bucket = find_bucket(key, hash_of(key));
+        if(bucket == buckets) return nullptr;
+        const auto idx = m_bucket_slot[bucket];
+        touch(idx);
+        return &ptr(idx)->second;
+    }
+
+    // like get() but without changing the recency order
+    const T* peek(const Key& key) const {
+        const auto bucket = find_bucket(key, hash_of(key));
+        return bucket == buckets ? nullptr : &ptr(m_bucket_slot[bucket])->second;
+    }
+    bool contains(const Key& key) const { return find_bucket(key, hash_of(key)) != buckets; }
+
+    // modifiers
+
+    // Assigns value to key, or inserts it, evicting the least recently used entry if the cache is full.
+    // Either way, key becomes the most recently used entry.
+    template<class M>
+    T& put(const Key& key, M&& value) {
+        return put_key(key, std::forward<M>(value));
+    }
+    template<class M>
+    T& put(Key&& key, M&& value) {
+        return put_key(std::move(key), std::forward<M>(value));
+    }
+
+    // Returns the value for key like get(), or constructs it from the result of factory() on a miss.
+    // factory is called before anything is evicted, so the cache is unchanged if it throws.
+    template<class Factory>
+    T& get_or_emplace(const Key& key, Factory&& factory) {
+        return get_or_emplace_key(key, std::forward<Factory>(factory));
+    }
+    template<class Factory>
+    T& get_or_emplace(Key&& key, Factory&& factory) {
+        return get_or_emplace_key(std::move(key), std::forward<Factory>(factory));
+    }
+
+    bool erase(const Key& key) {
+        const auto bucket = find_bucket(key, hash_of(key));
+        if(bucket == buckets) return false;
+        const auto idx = m_bucket_slot[bucket];
+        erase_bucket(bucket);
+        unlink(idx);
+        ptr(idx)->~value_type();
+        release(idx);
+        return true;
+    }
+
+    void clear() noexcept {
+        for(auto idx = m_links[sentinel].next; idx != sentinel; idx = m_links[idx].next) ptr(idx)->~value_type();
+        std::memset(m_ctrl, lyn_inplace_unordered_map_detail::empty_ctrl, sizeof m_ctrl);
+        m_links[sentinel] = link{sentinel, sentinel};
+        m_free = sentinel;
+        m_unused = 0;
+        m_size = 0;
+    }
+
+    // observers
+    hasher hash_function() const { return m_hash; }
+    key_equal key_eq() const { return m_equal; }
+
+private:
+    value_type* ptr(index_type idx) noexcept { return lyn_inplace_vector_detail::launder(&m_slots[idx].value); }
+    const value_type* ptr(index_type idx) const noexcept { return lyn_inplace_vector_detail::launder(&m_slots[idx].value); }
+
+    bool in_slot(index_type idx, const void* address) const noexcept {
+        const std::less<const void*> before{};
+        return !before(address, &m_slots[idx]) && before(address, &m_slots[idx] + 1);
+    }
+
+    std::uint64_t hash_of(const Key& key) const { return lyn_inplace_unordered_map_detail::mix(m_hash(key)); }
+    static size_type home_of(std::uint64_t hash) noexcept { return static_cast<size_type>(hash >> 7) & mask; }
+    static unsigned char tag_of(std::uint64_t hash) noexcept { return static_cast<unsigned char>(hash & 0x7F); }
+
+    bool ctrl_full(size_type bucket) const noexcept { return !(m_ctrl[bucket] & lyn_inplace_unordered_map_detail::empty_ctrl); }
+
+    // the first group_width control bytes are mirrored after the last bucket, as in inplace_unordered_map
+    void set_ctrl(size_type bucket, unsigned char ctrl) noexcept {
+        m_ctrl[bucket] = ctrl;
+        if(bucket < lyn_inplace_unordered_map_detail::group_width) m_ctrl[buckets + bucket] = ctrl;
+    }
+
+    // Returns buckets if key is not cached.
+    size_type find_bucket(const Key& key, std::uint64_t hash) const {
+        using namespace lyn_inplace_unordered_map_detail;
+        const auto tag = tag_of(hash);
+        for(size_type pos = home_of(hash);; pos = (pos + group_width) & mask) {
+            const group grp(m_ctrl + pos);
+            for(auto bits = grp.match(tag); bits; bits &= bits - 1) {
+                auto bucket = (pos + lyn_inplace_vector_detail::countr_zero(bits)) & mask;
+                if(m_equal(ptr(m_bucket_slot[bucket])->first, key)) return bucket;
+            }
+            if(grp.match_empty()) return buckets;
+        }
+    }
+
+    void index_slot(std::uint64_t hash, index_type idx) noexcept {
+        using namespace lyn_inplace_unordered_map_detail;
+        for(size_type pos = home_of(hash);; pos = (pos + group_width) & mask) {
+            if(auto bits = group(m_ctrl + pos).match_empty()) {
+                const auto bucket = (pos + lyn_inplace_vector_detail::countr_zero(bits)) & mask;
+                m_bucket_slot[bucket] = idx;
+                set_ctrl(bucket, tag_of(hash));
+                return;
+            }
+        }
+    }
+
+    // The bucket of an entry is found from its stored hash and slot number, without hashing or comparing
+    // its key.
+    size_type bucket_of(index_type idx) const noexcept {
+        auto bucket = home_of(m_slot_hash[idx]);
+        while(!ctrl_full(bucket) || m_bucket_slot[bucket] != idx) bucket = (bucket + 1) & mask;
+        return bucket;
+    }
+
+    // backward shift deletion, as in inplace_unordered_map
+    void erase_bucket(size_type hole) noexcept {
+        for(size_type bucket = (hole + 1) & mask; ctrl_full(bucket); bucket = (bucket + 1) & mask) {
+            const auto home = home_of(m_slot_hash[m_bucket_slot[bucket]]);
+            if(((bucket - home) & mask) >= ((bucket - hole) & mask)) {
+                m_bucket_slot[hole] = m_bucket_slot[bucket];
+                set_ctrl(hole, m_ctrl[bucket]);
+                hole = bucket;
+            }
+        }
+        set_ctrl(hole, lyn_inplace_unordered_map_detail::empty_ctrl);
+    }
+
+    void unlink(index_type idx) noexcept {
+        m_links[m_links[idx].prev].next = m_links[idx].next;
+        m_links[m_links[idx].next].prev = m_links[idx].prev;
+    }
+    void link_front(index_type idx) noexcept {
+        const auto first = m_links[sentinel].next;
+        m_links[idx] = link{sentinel, first};
+        m_links[first].prev = idx;
+        m_links[sentinel].next = idx;
+    }
+    void touch(index_type idx) noexcept {
+        if(m_links[sentinel].next == idx) return;
+        unlink(idx);
+        link_front(idx);
+    }
+
+    void release(index_type idx) noexcept {
+        m_links[idx].next = m_free;
+        m_free = idx;
+        --m_size;
+    }
+
+    void evict() noexcept {
+        const auto idx = m_links[sentinel].prev;
+        erase_bucket(bucket_of(idx));
+        unlink(idx);
+        ptr(idx)->~value_type();
+        release(idx);
+    }
+
+    // Precondition: the key is not cached. A full cache evicts the least recently used entry and constructs the
+    // new one in its slot. If key or mapped is a part of the evicted entry, the new entry is first built in a
+    // temporary node and then moved into the slot, which does not throw. Otherwise, if the construction throws,
+    // the evicted entry stays evicted.
+    template<class K, class M>
+    value_type& emplace_new(std::uint64_t hash, K&& key, M&& mapped) {
+        if(full()) {
+            const auto victim = m_links[sentinel].prev;
+            if(in_slot(victim, std::addressof(key)) || in_slot(victim, std::addressof(mapped))) {
+                node entry;
+                ::new(static_cast<void*>(&entry.value)) value_type(std::forward<K>(key), std::forward<M>(mapped));
+                evict();
+                auto& rv = emplace_slot(hash, std::move(entry.moving.first), std::move(entry.moving.second));
+                lyn_inplace_vector_detail::launder(&entry.value)->~value_type();
+                return rv;
+            }
+            evict();
+        }
+        return emplace_slot(hash, std::forward<K>(key), std::forward<M>(mapped));
+    }
+    // Precondition: the key is not cached and the cache is not full. The slot is taken from the free list only
+    // after the entry has been constructed in it, so that nothing needs to be undone if the constructor throws.
+    template<class... Args>
+    value_type& emplace_slot(std::uint64_t hash, Args&&... args) {
+        const auto idx = m_free != sentinel ? m_free : m_unused;
+        ::new(static_cast<void*>(&m_slots[idx].value)) value_type(std::forward<Args>(args)...);
+        if(idx == m_free) {
+            m_free = m_links[idx].next;
+        } else {
+            ++m_unused;
+        }
+        m_slot_hash[idx] = hash;
+        index_slot(hash, idx);
+        link_front(idx);
+        ++m_size;
+        return *ptr(idx);
+    }
+
+    template<class K, class M>
+    T& put_key(K&& key, M&& value) {
+        const auto hash = hash_of(key);
+        const auto bucket = find_bucket(key, hash);
+        if(bucket != buckets) {
+            const auto idx = m_bucket_slot[bucket];
+            ptr(idx)->second = std::forward<M>(value);
+            touch(idx);
+            return ptr(idx)->second;
+        }
+        return emplace_new(hash, std::forward<K>(key), std::forward<M>(value)).second;
+    }
+
+    template<class K, class Factory>
+    T& get_or_emplace_key(K&& key, Factory&& factory) {
+        const auto hash = hash_of(key);
+        const auto bucket = find_bucket(key, hash);
+        if(bucket != buckets) {
+            const auto idx = m_bucket_slot[bucket];
+            touch(idx);
+            return ptr(idx)->second;
+        }
+        return emplace_new(hash, std::forward<K>(key), std::forward<Factory>(factory)()).second;
+    }
+
+    // precondition, for both: the cache is empty, so nothing is evicted
+    void copy_from(const inplace_lru_cache& other) {
+        for(auto idx = other.m_links[sentinel].prev; idx != sentinel; idx = other.m_links[idx].prev) {
+            emplace_slot(other.m_slot_hash[idx], *other.ptr(idx));
+        }
+    }
+    // other is cleared right after, so the keys are moved too
+    void copy_from(inplace_lru_cache& other) noexcept {
+        for(auto idx = other.m_links[sentinel].prev; idx != sentinel; idx = other.m_links[idx].prev) {
+            auto& entry = other.m_slots[idx].moving;
+            emplace_slot(other.m_slot_hash[idx], std::move(entry.first), std::move(entry.second));
+        }
+    }
+
+    link m_links[N + 1];                   // m_links[N] is the sentinel, linking the least and the most recently used entry
+    node m_slots[N];                       // uninitialized until an entry is constructed in it
+    std::uint64_t m_slot_hash[N];          // the mixed hash of the key in each slot
+    index_type m_bucket_slot[buckets];     // the slot of the entry in each full bucket
+    unsigned char m_ctrl[buckets + lyn_inplace_unordered_map_detail::group_width];
+    index_type m_free = sentinel;          // first free slot that has been used before, linked through next
+    index_type m_unused = 0;               // the slots from here on have never been used
+    index_type m_size = 0;
+    Hash m_hash;
+    KeyEqual m_equal;
+};
+
+template<class Key, class T, std::size_t N, class Hash, class KeyEqual>
+constexpr typename inplace_lru_cache<Key, T, N, Hash, KeyEqual>::index_type inplace_lru_cache<Key, T, N, Hash, KeyEqual>::sentinel;
+template<class Key, class T, std::size_t N, class Hash, class KeyEqual>
+constexpr std::size_t inplace_lru_cache<Key, T, N, Hash, KeyEqual>::buckets;
+template<class Key, class T, std::size_t N, class Hash, class KeyEqual>
+constexpr std::size_t inplace_lru_cache<Key, T, N, Hash, KeyEqual>::mask;
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,176 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_175D0730_CB68_11F1_A9FB_02FC00000001
+#define LYNIPV_175D0730_CB68_11F1_A9FB_02FC00000001
+
+#if __cplusplus >= 201703L
+
+# include <cstddef>
+# include <cstdint>
+# include <memory_resource>
+# include <new>
+
+namespace lyn {
+
+namespace lyn_inplace_memory_resource_detail {
+    // Blocks of up to max_class bytes, with alignments up to granule, are rounded up to a power of two
+    // size class and put on the free list of the class when deallocated, to be reused by the next
+    // allocation of the class.
+    constexpr std::size_t granule = 16;
+    constexpr std::size_t max_class = 512;
+    constexpr std::size_t class_count = 6; // 16, 32, 64, 128, 256 and 512
+
+    inline std::size_t class_of(std::size_t bytes) noexcept {
+        std::size_t cls = 0;
+        for(std::size_t size = granule; size < bytes; size *= 2) ++cls;
+        return cls;
+    }
+    constexpr std::size_t class_size(std::size_t cls) noexcept { return granule << cls; }
+
+    struct free_block {
+        free_block* next;
+    };
+} // namespace lyn_inplace_memory_resource_detail
+
+// A std::pmr::memory_resource that hands out memory from a buffer of Bytes bytes in the object itself and
+// turns to an upstream resource when the buffer is exhausted. Allocation bumps a pointer, and release()
+// resets it in O(1), making all memory allocated from the buffer available again.
+//
+// Deallocated blocks are not all lost until release(): a block that ends at the bump pointer is returned
+// to the buffer by moving the pointer back, and with SizeClasses, other small blocks are kept on per size
+// class free lists and reused. Blocks allocated upstream are returned upstream when they are
+// deallocated, also after release().
+//
+// Pass std::pmr::null_memory_resource() as upstream to make exhausting the buffer throw std::bad_alloc.
+// The resource is not thread safe.
+template<std::size_t Bytes, std::size_t Align = alignof(std::max_align_t), bool SizeClasses = true>
+class inplace_memory_resource : public std::pmr::memory_resource {
+    static_assert(Bytes != 0, "inplace_memory_resource: Bytes must be greater than zero");
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "inplace_memory_resource: Align must be a power of two");
+
+public:
+    inplace_memory_resource() noexcept : inplace_memory_resource(std::pmr::get_default_resource()) {}
+    explicit inplace_memory_resource(std::pmr::memory_resource* upstream) noexcept : m_upstream(upstream) {}
+    inplace_memory_resource(const inplace_memory_resource&) = delete;
+    inplace_memory_resource& operator=(const inplace_memory_resource&) = delete;
+
+    // Makes the whole buffer available again. Precondition: no block allocated from the buffer is in use.
+    void release() noexcept {
+        m_used = 0;
+        for(auto& head : m_free) head = nullptr;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept { return m_upstream; }
+
+    // statistics
+    static constexpr std::size_t capacity() noexcept { return Bytes; }
+    // the bytes of the buffer up to the bump pointer, including freed blocks waiting for reuse
+    std::size_t bytes_used() const noexcept { return m_used; }
+    // the highest bytes_used() since construction or reset_statistics()
+    std::size_t high_water_mark() const noexcept { return m_high_water; }
+    // the number of allocations, and their total size, that did not fit in the buffer and went upstream
+    std::size_t upstream_fallbacks() const noexcept { return m_fallbacks; }
+    std::size_t upstream_bytes() const noexcept { return m_fallback_bytes; }
+    void reset_statistics() noexcept {
+        m_high_water = m_used;
+        m_fallbacks = 0;
+        m_fallback_bytes = 0;
+    }
+
+private:
+    using free_block = lyn_inplace_memory_resource_detail::free_block;
+
+    static bool classed(std::size_t bytes, std::size_t alignment) noexcept {
+        return SizeClasses && bytes <= lyn_inplace_memory_resource_detail::max_class &&
+               alignment <= lyn_inplace_memory_resource_detail::granule;
+    }
+
+    bool owns(const void* ptr) const noexcept {
+        const auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+        const auto base = reinterpret_cast<std::uintptr_t>(m_buffer);
+        return addr >= base && addr < base + Bytes;
+    }
+
+    void* bump(std::size_t bytes, std::size_t alignment) noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(m_buffer);
+        const auto pos = (base + m_used + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        if(pos - base > Bytes || bytes > Bytes - (pos - base)) return nullptr;
+        m_used = pos - base + bytes;
+        if(m_used > m_high_water) m_high_water = m_used;
+        return reinterpret_cast<void*>(pos);
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* rv;
+        if(classed(bytes, alignment)) {
+            using namespace lyn_inplace_memory_resource_detail;
+            const auto cls = class_of(bytes);
+            if(auto block = m_free[cls]) {
+                m_free[cls] = block->next;
+                return block;
+            }
+            rv = bump(class_size(cls), granule);
+        } else {
+            rv = bump(bytes, alignment);
+        }
+        if(rv) return rv;
+        ++m_fallbacks;
+        m_fallback_bytes += bytes;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        if(!owns(ptr)) return m_upstream->deallocate(ptr, bytes, alignment);
+        const bool small = classed(bytes, alignment);
+        const auto cls = small ? lyn_inplace_memory_resource_detail::class_of(bytes) : 0;
+        const auto size = small ? lyn_inplace_memory_resource_detail::class_size(cls) : bytes;
+        if(static_cast<unsigned char*>(ptr) + size == m_buffer + m_used) {
+            m_used = static_cast<std::size_t>(static_cast<unsigned char*>(ptr) - m_buffer);
+        } else if(small) {
+            m_free[cls] = ::new(ptr) free_block{m_free[cls]};
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    alignas(Align) unsigned char m_buffer[Bytes];
+    std::size_t m_used = 0;
+    free_block* m_free[lyn_inplace_memory_resource_detail::class_count]{};
+    std::pmr::memory_resource* m_upstream;
+    std::size_t m_high_water = 0;
+    std::size_t m_fallbacks = 0;
+    std::size_t m_fallback_bytes = 0;
+};
+
+} // namespace lyn
+
+#endif
+
+#endif
@@ -0,0 +1,486 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_C1C4B536_CB65_11F1_8E0C_02FC00000001
+#define LYNIPV_C1C4B536_CB65_11F1_8E0C_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace lyn {
+
+namespace lyn_inplace_packed_vector_detail {
+    using word_type = std::uint64_t;
+    constexpr std::size_t word_bits = 64;
+
+    // the default element type: bool for single bits, otherwise the smallest unsigned type holding Bits
+    template<std::size_t Bits>
+    using default_value_type = typename std::conditional<
+        Bits == 1, bool,
+        typename std::conditional<
+            (Bits <= 8), std::uint8_t,
+            typename std::conditional<(Bits <= 16), std::uint16_t,
+                                      typename std::conditional<(Bits <= 32), std::uint32_t, std::uint64_t>::type>::type>::type>::type;
+
+    template<class T, bool = std::is_enum<T>::value>
+    struct unsigned_of {
+        using type = typename std::make_unsigned<typename std::underlying_type<T>::type>::type;
+    };
+    template<class T>
+    struct unsigned_of<T, false> {
+        using type = typename std::make_unsigned<T>::type;
+    };
+    template<>
+    struct unsigned_of<bool, false> {
+        using type = unsigned;
+    };
+
+    // The layout of a word holding Bits wide fields. Fields never straddle words, so when Bits does not
+    // divide 64, the top 64 % Bits bits of every word are unused.
+    template<std::size_t Bits>
+    struct layout {
+        static constexpr std::size_t per_word = word_bits / Bits;
+        static constexpr word_type field = (word_type{1} << Bits) - 1;
+        static constexpr word_type used = per_word * Bits == word_bits ? ~word_type{0} : (word_type{1} << (per_word * Bits)) - 1;
+
+        // value repeated in every field, for the constants - at run time, multiply by ones instead
+        static constexpr word_type broadcast(word_type value, std::size_t fields = per_word) {
+            return fields == 0 ? 0 : value | (broadcast(value, fields - 1) << Bits);
+        }
+        static constexpr word_type ones = broadcast(1);
+        static constexpr word_type high = ones << (Bits - 1);
+        static constexpr word_type low_bits = used & ~high;
+
+        // The top bit of every field that is not zero. Adding the low Bits - 1 bits of a field to all ones
+        // carries into its top bit unless they are all zero, and the carry never leaves the field.
+        static word_type nonzero(word_type word) noexcept { return (((word & low_bits) + low_bits) | word) & high; }
+    };
+} // namespace lyn_inplace_packed_vector_detail
+
+// A sequence of at most N elements of Bits bits each, packed into 64 bit words in the object itself. The
+// elements are integers, enums or bool, stored as their low Bits bits and read back zero extended, so T
+// values must fit in Bits bits as an unsigned number. Element access goes through proxy references, like
+// std::vector<bool>.
+//
+// Besides the sequence operations, count(), find_first() and find_next() and the bitwise operators work a
+// word at a time. The bits after the last element are always zero.
+template<std::size_t Bits, std::size_t N, class T = lyn_inplace_packed_vector_detail::default_value_type<Bits>>
+class inplace_packed_vector {
+    static_assert(Bits != 0 && Bits <= 32, "inplace_packed_vector: Bits must be in [1, 32]");
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "inplace_packed_vector: T must be an integral or enum type");
+    static_assert(N != 0, "inplace_packed_vector: N must be greater than zero");
+
+    using layout = lyn_inplace_packed_vector_detail::layout<Bits>;
+    using unsigned_type = typename lyn_inplace_packed_vector_detail::unsigned_of<T>::type;
+    static constexpr std::size_t word_count = (N + layout::per_word - 1) / layout::per_word;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = T;
+    using word_type = lyn_inplace_packed_vector_detail::word_type;
+
+    static constexpr size_type bits_per_element = Bits;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    class reference {
+    public:
+        operator T() const noexcept { return from_field((*m_word >> m_shift) & layout::field); }
+        reference& operator=(T value) noexcept {
+            *m_word = (*m_word & ~(layout::field << m_shift)) | (to_field(value) << m_shift);
+            return *this;
+        }
+        reference& operator=(const reference& other) noexcept { return *this = static_cast<T>(other); }
+        friend void swap(reference lhs, reference rhs) noexcept {
+            const T tmp = lhs;
+            lhs = static_cast<T>(rhs);
+            rhs = tmp;
+        }
+
+    private:
+        friend class inplace_packed_vector;
+        reference(word_type* word, unsigned shift) noexcept : m_word(word), m_shift(shift) {}
+        word_type* m_word;
+        unsigned m_shift;
+    };
+
+private:
+    template<bool Const>
+    class basic_iterator {
+        using vector_ptr = typename std::conditional<Const, const inplace_packed_vector*, inplace_packed_vector*>::type;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = typename std::conditional<Const, T, typename inplace_packed_vector::reference>::type;
+
+        basic_iterator() = default;
+        template<bool C = Const, typename std::enable_if<C, int>::type = 0>
+        basic_iterator(const basic_iterator<false>& other) noexcept : m_vec(other.m_vec), m_idx(other.m_idx) {}
+
+        reference operator*() const noexcept { return (*m_vec)[m_idx]; }
+        reference operator[](difference_type off) const noexcept { return (*m_vec)[m_idx + static_cast<size_type>(off)]; }
+
+        basic_iterator& operator++() noexcept {
+            ++m_idx;
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto rv = *this;
+            ++m_idx;
+            return rv;
+        }
+        basic_iterator& operator--() noexcept {
+            --m_idx;
+            return *this;
+        }
+        basic_iterator operator--(int) noexcept {
+            auto rv = *this;
+            --m_idx;
+            return rv;
+        }
+        basic_iterator& operator+=(difference_type off) noexcept {
+            m_idx += static_cast<size_type>(off);
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type off) noexcept {
+            m_idx -= static_cast<size_type>(off);
+            return *this;
+        }
+        friend basic_iterator operator+(basic_iterator it, difference_type off) noexcept { return it += off; }
+        friend basic_iterator operator+(difference_type off, basic_iterator it) noexcept { return it += off; }
+        friend basic_iterator operator-(basic_iterator it, difference_type off) noexcept { return it -= off; }
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.m_idx) - static_cast<difference_type>(rhs.m_idx);
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx == rhs.m_idx; }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx != rhs.m_idx; }
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx < rhs.m_idx; }
+        friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx > rhs.m_idx; }
+        friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx <= rhs.m_idx; }
+        friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx >= rhs.m_idx; }
+
+    private:
+        friend class inplace_packed_vector;
+        template<bool>
+        friend class basic_iterator;
+        basic_iterator(vector_ptr vec, size_type idx) noexcept : m_vec(vec), m_idx(idx) {}
+
+        vector_ptr m_vec = nullptr;
+        size_type m_idx = 0;
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // constructors
+    inplace_packed_vector() noexcept : m_words{} {}
+    explicit inplace_packed_vector(size_type count) : inplace_packed_vector() { resize(count); }
+    inplace_packed_vector(size_type count, T value) : inplace_packed_vector() { resize(count, value); }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    inplace_packed_vector(InputIt first, InputIt last) : inplace_packed_vector() {
+        for(; first != last; ++first) push_back(static_cast<T>(*first));
+    }
+    inplace_packed_vector(std::initializer_list<T> ilist) : inplace_packed_vector(ilist.begin(), ilist.end()) {}
+
+    // iterators
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, m_size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // capacity
+    bool empty() const noexcept { return m_size == 0; }
+    bool full() const noexcept { return m_size == N; }
+    size_type size() const noexcept { return m_size; }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // Grows with copies of value or shrinks, clearing the bits of the removed elements.
+    void resize(size_type count, T value = T()) {
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        if(count < m_size) {
+            const auto old_size = m_size;
+            m_size = count;
+            clear_tail(old_size);
+        } else {
+            fill(m_size, count, value);
+            m_size = count;
+        }
+    }
+
+    // element access
+    reference operator[](size_type idx) noexcept {
+        return reference(&m_words[idx / layout::per_word], static_cast<unsigned>(idx % layout::per_word * Bits));
+    }
+    T operator[](size_type idx) const noexcept { return get(idx); }
+    reference at(size_type idx) {
+        if(idx >= m_size) lyn_inplace_vector_detail::throw_out_of_range();
+        return (*this)[idx];
+    }
+    T at(size_type idx) const {
+        if(idx >= m_size) lyn_inplace_vector_detail::throw_out_of_range();
+        return get(idx);
+    }
+    reference front() noexcept { return (*this)[0]; }
+    T front() const noexcept { return get(0); }
+    reference back() noexcept { return (*this)[m_size - 1]; }
+    T back() const noexcept { return get(m_size - 1); }
+
+    // The words holding the elements, least significant field first, for serialization. The bits after
+    // the last element are zero.
+    const word_type* word_data() const noexcept { return m_words; }
+    size_type word_size() const noexcept { return (m_size + layout::per_word - 1) / layout::per_word; }
+
+    // modifiers
+    void push_back(T value) {
+        if(full()) lyn_inplace_vector_detail::throw_bad_alloc();
+        unchecked_push_back(value);
+    }
+    bool try_push_back(T value) noexcept {
+        if(full()) return false;
+        unchecked_push_back(value);
+        return true;
+    }
+    // the bits after the last element are zero, so the new element only needs to be or:ed in
+    void unchecked_push_back(T value) noexcept {
+        m_words[m_size / layout::per_word] |= to_field(value) << (m_size % layout::per_word * Bits);
+        ++m_size;
+    }
+    void pop_back() noexcept { set(--m_size, T()); }
+
+    // Inserting and erasing single elements shift the following elements a word at a time.
+    iterator insert(const_iterator pos, T value) {
+        if(full()) lyn_inplace_vector_detail::throw_bad_alloc();
+        const auto idx = pos.m_idx;
+        shift_up(idx);
+        ++m_size;
+        set(idx, value);
+        return iterator(this, idx);
+    }
+    iterator insert(const_iterator pos, size_type count, T value) {
+        if(count > N - m_size) lyn_inplace_vector_detail::throw_bad_alloc();
+        const auto idx = pos.m_idx;
+        for(size_type src = m_size; src-- != idx;) set(src + count, get(src));
+        fill(idx, idx + count, value);
+        m_size += count;
+        return iterator(this, idx);
+    }
+    iterator erase(const_iterator pos) noexcept {
+        const auto idx = pos.m_idx;
+        shift_down(idx);
+        --m_size;
+        return iterator(this, idx);
+    }
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        const auto dst = first.m_idx;
+        const auto count = last.m_idx - first.m_idx;
+        for(size_type src = last.m_idx; src != m_size; ++src) set(src - count, get(src));
+        const auto old_size = m_size;
+        m_size -= count;
+        clear_tail(old_size);
+        return iterator(this, dst);
+    }
+    void clear() noexcept {
+        for(auto& word : m_words) word = 0;
+        m_size = 0;
+    }
+
+    // word level queries
+
+    // the number of elements that are not zero - the number of set bits for Bits == 1
+    size_type count() const noexcept {
+        size_type rv = 0;
+        for(size_type idx = 0, end = word_size(); idx != end; ++idx) {
+            rv += lyn_inplace_vector_detail::popcount(static_cast<unsigned long long>(layout::nonzero(m_words[idx])));
+        }
+        return rv;
+    }
+    // the number of elements equal to value
+    size_type count(T value) const noexcept {
+        size_type rv = 0;
+        const auto pattern = to_field(value) * layout::ones;
+        for(size_type idx = 0, end = word_size(); idx != end; ++idx) {
+            rv += lyn_inplace_vector_detail::popcount(
+                static_cast<unsigned long long>(~layout::nonzero(m_words[idx] ^ pattern) & layout::high & valid(idx)));
+        }
+        return rv;
+    }
+
+    // the index of the first element from pos that is not zero, or equal to value, or npos if there is none
+    size_type find_first() const noexcept { return find_next(0); }
+    size_type find_first(T value) const noexcept { return find_next(0, value); }
+    size_type find_next(size_type pos) const noexcept {
+        return find_word(pos, [](word_type word) { return layout::nonzero(word); });
+    }
+    size_type find_next(size_type pos, T value) const noexcept {
+        const auto pattern = to_field(value) * layout::ones;
+        return find_word(pos, [pattern](word_type word) { return ~layout::nonzero(word ^ pattern) & layout::high; });
+    }
+
+    // Bitwise operations on the elements of two vectors of the same size. Precondition: size() == other.size()
+    inplace_packed_vector& operator&=(const inplace_packed_vector& other) noexcept {
+        for(size_type idx = 0, end = word_size(); idx != end; ++idx) m_words[idx] &= other.m_words[idx];
+        return *this;
+    }
+    inplace_packed_vector& operator|=(const inplace_packed_vector& other) noexcept {
+        for(size_type idx = 0, end = word_size(); idx != end; ++idx) m_words[idx] |= other.m_words[idx];
+        return *this;
+    }
+    inplace_packed_vector& operator^=(const inplace_packed_vector& other) noexcept {
+        for(size_type idx = 0, end = word_size(); idx != end; ++idx) m_words[idx] ^= other.m_words[idx];
+        return *this;
+    }
+    // inverts all bits of all elements
+    void flip() noexcept {
+        for(size_type idx = 0, end = word_size(); idx != end; ++idx) m_words[idx] = ~m_words[idx] & layout::used;
+        clear_tail(m_size);
+    }
+
+    friend inplace_packed_vector operator&(inplace_packed_vector lhs, const inplace_packed_vector& rhs) noexcept { return lhs &= rhs; }
+    friend inplace_packed_vector operator|(inplace_packed_vector lhs, const inplace_packed_vector& rhs) noexcept { return lhs |= rhs; }
+    friend inplace_packed_vector operator^(inplace_packed_vector lhs, const inplace_packed_vector& rhs) noexcept { return lhs ^= rhs; }
+
+    // Since the bits after the last element are zero, equal vectors have equal words.
+    friend bool operator==(const inplace_packed_vector& lhs, const inplace_packed_vector& rhs) noexcept {
+        if(lhs.m_size != rhs.m_size) return false;
+        for(size_type idx = 0, end = lhs.word_size(); idx != end; ++idx) {
+            if(lhs.m_words[idx] != rhs.m_words[idx]) return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const inplace_packed_vector& lhs, const inplace_packed_vector& rhs) noexcept { return !(lhs == rhs); }
+
+private:
+    static word_type to_field(T value) noexcept { return static_cast<word_type>(static_cast<unsigned_type>(value)) & layout::field; }
+    static T from_field(word_type field) noexcept { return static_cast<T>(static_cast<unsigned_type>(field)); }
+
+    T get(size_type idx) const noexcept {
+        return from_field((m_words[idx / layout::per_word] >> (idx % layout::per_word * Bits)) & layout::field);
+    }
+    void set(size_type idx, T value) noexcept { (*this)[idx] = value; }
+
+    void fill(size_type first, size_type last, T value) noexcept {
+        for(; first != last; ++first) set(first, value);
+    }
+
+    // the top bits of the fields of word idx that hold elements
+    word_type valid(size_type idx) const noexcept {
+        const auto in_word = m_size - idx * layout::per_word;
+        return in_word >= layout::per_word ? layout::high : layout::high & ((word_type{1} << (in_word * Bits)) - 1);
+    }
+
+    // clears the fields from m_size up to old_size, after the size has shrunk
+    void clear_tail(size_type old_size) noexcept {
+        const auto word = m_size / layout::per_word;
+        const auto end = (old_size + layout::per_word - 1) / layout::per_word;
+        if(word >= end) return;
+        m_words[word] &= below(m_size);
+        for(auto idx = word + 1; idx < end; ++idx) m_words[idx] = 0;
+    }
+
+    template<class Match>
+    size_type find_word(size_type pos, Match match) const noexcept {
+        if(pos >= m_size) return npos;
+        auto word = pos / layout::per_word;
+        // the fields before pos in the first word
+        auto bits = match(m_words[word]) & ~((word_type{1} << (pos % layout::per_word * Bits)) - 1);
+        for(const auto end = word_size();;) {
+            bits &= valid(word);
+            if(bits) {
+                return word * layout::per_word + lyn_inplace_vector_detail::countr_zero(static_cast<unsigned long long>(bits)) / Bits;
+            }
+            if(++word == end) return npos;
+            bits = match(m_words[word]);
+        }
+    }
+
+    // the fields below idx in its word, which stay where they are when shifting from idx
+    static word_type below(size_type idx) noexcept { return (word_type{1} << (idx % layout::per_word * Bits)) - 1; }
+
+    // Makes room at idx by moving the fields from idx one field up, carrying the top field of every word
+    // into the bottom of the next. Precondition: !full()
+    void shift_up(size_type idx) noexcept {
+        word_type keep = below(idx);
+        word_type carry = 0;
+        for(auto word = idx / layout::per_word, last = m_size / layout::per_word; word <= last; ++word, keep = 0) {
+            const auto old = m_words[word];
+            m_words[word] = (old & keep) | (((old & ~keep) << Bits) & layout::used) | carry;
+            carry = old >> ((layout::per_word - 1) * Bits) & layout::field;
+        }
+    }
+
+    // Removes the element at idx by moving the following fields one field down, pulling the bottom field of
+    // every word into the top of the previous. Precondition: idx < size()
+    void shift_down(size_type idx) noexcept {
+        word_type keep = below(idx);
+        for(auto word = idx / layout::per_word, last = (m_size - 1) / layout::per_word; word <= last; ++word, keep = 0) {
+            const auto old = m_words[word];
+            const auto next = word + 1 != word_count ? m_words[word + 1] & layout::field : 0;
+            m_words[word] = (old & keep) | ((old >> Bits) & ~keep) | (next << ((layout::per_word - 1) * Bits));
+        }
+    }
+
+    word_type m_words[word_count];
+    size_type m_size = 0;
+};
+
+template<std::size_t Bits, std::size_t N, class T>
+constexpr std::size_t inplace_packed_vector<Bits, N, T>::bits_per_element;
+template<std::size_t Bits, std::size_t N, class T>
+constexpr std::size_t inplace_packed_vector<Bits, N, T>::npos;
+template<std::size_t Bits, std::size_t N, class T>
+constexpr std::size_t inplace_packed_vector<Bits, N, T>::word_count;
+
+// a vector of N bools, one bit each
+template<std::size_t N>
+using inplace_bit_vector = inplace_packed_vector<1, N, bool>;
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,358 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_927F93EE_CB5C_11F1_BADD_02FC00000001
+#define LYNIPV_927F93EE_CB5C_11F1_BADD_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define LYNIPV_HAS_SSE2
+# include <emmintrin.h>
+#endif
+
+// Set algorithms over sorted inplace_vectors of 32 and 64 bit integers. The results are appended to the
+// destination, which must not be one of the sources. The destination's capacity is checked once against
+// the largest possible result, after which the elements are appended unchecked. If the largest possible
+// result does not fit, every append is checked and std::bad_alloc is thrown only if the actual result
+// does not fit, leaving what was appended so far.
+//
+// The sources of set_intersection, intersection_size, set_union and set_difference must be strictly
+// increasing. merge accepts duplicates.
+
+namespace lyn {
+
+namespace lyn_inplace_set_algorithm_detail {
+    template<class T>
+    struct is_set_integer :
+        std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value && (sizeof(T) == 4 || sizeof(T) == 8)> {
+    };
+
+    // When one source is this many times bigger than the other, the elements of the smaller one are
+    // looked up in the bigger one instead of walking both.
+    constexpr std::size_t gallop_ratio = 32;
+
+    // std::lower_bound after probing 1, 2, 4 ... elements ahead, which is cheap when the result is near first
+    template<class T>
+    const T* gallop(const T* first, const T* last, T value) {
+        const auto count = static_cast<std::size_t>(last - first);
+        if(count == 0 || !(*first < value)) return first;
+        std::size_t bound = 1;
+        while(bound < count && first[bound] < value) bound *= 2;
+        return std::lower_bound(first + bound / 2, first + std::min(bound + 1, count), value);
+    }
+
+    template<class T, std::size_t K>
+    struct unchecked_append {
+        inplace_vector<T, K>& out;
+        void operator()(T value) const { out.unchecked_push_back(value); }
+    };
+    template<class T, std::size_t K>
+    struct checked_append {
+        inplace_vector<T, K>& out;
+        void operator()(T value) const { out.push_back(value); }
+    };
+    struct counter {
+        std::size_t count;
+        template<class T>
+        void operator()(T) noexcept {
+            ++count;
+        }
+    };
+
+    template<class T, class Out>
+    void append_run(const T* first, const T* last, Out& out) {
+        for(; first != last; ++first) out(*first);
+    }
+
+    // the advancing is branch free, only matches branch
+    template<class T, class Out>
+    void intersect_scalar(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+        std::size_t ia = 0, ib = 0;
+        while(ia < na && ib < nb) {
+            const T va = a[ia], vb = b[ib];
+            if(va == vb) out(va);
+            ia += va <= vb;
+            ib += vb <= va;
+        }
+    }
+
+    // looks up the elements of small in big
+    template<class T, class Out>
+    void intersect_gallop(const T* small, std::size_t nsmall, const T* big, std::size_t nbig, Out& out) {
+        const T* pos = big;
+        const T* const end = big + nbig;
+        for(std::size_t idx = 0; idx != nsmall && pos != end; ++idx) {
+            pos = gallop(pos, end, small[idx]);
+            if(pos != end && *pos == small[idx]) out(*pos++);
+        }
+    }
+
+#ifdef LYNIPV_HAS_SSE2
+    // Bit i is set if a[i] equals any of b[0] ... b[3], found by comparing a with b rotated 0, 1, 2 and 3 lanes.
+    inline unsigned match_block(const void* a, const void* b) noexcept {
+        const __m128i va = _mm_loadu_si128(static_cast<const __m128i*>(a));
+        const __m128i vb = _mm_loadu_si128(static_cast<const __m128i*>(b));
+        const __m128i eq01 = _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        const __m128i eq23 = _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                                          _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(eq01, eq23))));
+    }
+
+    // Compares blocks of four elements all-against-all and advances past the block with the smaller last
+    // element, or both if they are equal.
+    template<class T, class Out>
+    void intersect_sse2(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+        std::size_t ia = 0, ib = 0;
+        while(ia + 4 <= na && ib + 4 <= nb) {
+            for(auto bits = match_block(a + ia, b + ib); bits; bits &= bits - 1) {
+                out(a[ia + lyn_inplace_vector_detail::countr_zero(bits)]);
+            }
+            const T amax = a[ia + 3], bmax = b[ib + 3];
+            ia += amax <= bmax ? 4 : 0;
+            ib += bmax <= amax ? 4 : 0;
+        }
+        intersect_scalar(a + ia, na - ia, b + ib, nb - ib, out);
+    }
+#endif
+
+    template<class T, class Out>
+    void intersect_blocks(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out, std::true_type) {
+#ifdef LYNIPV_HAS_SSE2
+        intersect_sse2(a, na, b, nb, out);
+#else
+        intersect_scalar(a, na, b, nb, out);
+#endif
+    }
+    template<class T, class Out>
+    void intersect_blocks(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out, std::false_type) {
+        intersect_scalar(a, na, b, nb, out);
+    }
+
+    template<class T, class Out>
+    void intersect(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+        if(na * gallop_ratio < nb) return intersect_gallop(a, na, b, nb, out);
+        if(nb * gallop_ratio < na) return intersect_gallop(b, nb, a, na, out);
+        intersect_blocks(a, na, b, nb, out, std::integral_constant<bool, sizeof(T) == 4>{});
+    }
+
+    // Appends the union, or with Merge all elements of both. Equal integers are indistinguishable so ties
+    // may be taken from either source.
+    template<bool Merge, class T, class Out>
+    void unite(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+        if(na * gallop_ratio < nb || nb * gallop_ratio < na) {
+            if(na > nb) {
+                std::swap(a, b);
+                std::swap(na, nb);
+            }
+            const T* pos = b;
+            const T* const end = b + nb;
+            for(std::size_t idx = 0; idx != na; ++idx) {
+                const T* next = gallop(pos, end, a[idx]);
+                append_run(pos, next, out);
+                pos = next;
+                if(!Merge && pos != end && *pos == a[idx]) ++pos;
+                out(a[idx]);
+            }
+            return append_run(pos, end, out);
+        }
+        std::size_t ia = 0, ib = 0;
+        while(ia < na && ib < nb) {
+            const T va = a[ia], vb = b[ib];
+            out(vb < va ? vb : va);
+            if(Merge) {
+                ib += vb < va;
+                ia += !(vb < va);
+            } else {
+                ia += va <= vb;
+                ib += vb <= va;
+            }
+        }
+        append_run(a + ia, a + na, out);
+        append_run(b + ib, b + nb, out);
+    }
+
+    template<class T, class Out>
+    void subtract_scalar(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+        std::size_t ia = 0, ib = 0;
+        while(ia < na && ib < nb) {
+            const T va = a[ia], vb = b[ib];
+            if(va < vb) out(va);
+            ia += va <= vb;
+            ib += vb <= va;
+        }
+        append_run(a + ia, a + na, out);
+    }
+
+#ifdef LYNIPV_HAS_SSE2
+    // The matches of a block of a are collected over the blocks of b it meets and the unmatched elements
+    // are appended when a moves on.
+    template<class T, class Out>
+    void subtract_sse2(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+        std::size_t ia = 0, ib = 0;
+        unsigned matched = 0;
+        while(ia + 4 <= na && ib + 4 <= nb) {
+            matched |= match_block(a + ia, b + ib);
+            const T amax = a[ia + 3], bmax = b[ib + 3];
+            if(amax <= bmax) {
+                for(auto rest = ~matched & 0xFU; rest; rest &= rest - 1) out(a[ia + lyn_inplace_vector_detail::countr_zero(rest)]);
+                matched = 0;
+                ia += 4;
+            }
+            ib += bmax <= amax ? 4 : 0;
+        }
+        if(ia + 4 <= na) {
+            // b ran out of blocks in the middle of this block of a
+            for(std::size_t idx = 0; idx != 4; ++idx) {
+                const T va = a[ia + idx];
+                while(ib < nb && b[ib] < va) ++ib;
+                if(!(matched >> idx & 1U) && (ib == nb || b[ib] != va)) out(va);
+            }
+            ia += 4;
+        }
+        subtract_scalar(a + ia, na - ia, b + ib, nb - ib, out);
+    }
+#endif
+
+    template<class T, class Out>
+    void subtract_blocks(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out, std::true_type) {
+#ifdef LYNIPV_HAS_SSE2
+        subtract_sse2(a, na, b, nb, out);
+#else
+        subtract_scalar(a, na, b, nb, out);
+#endif
+    }
+    template<class T, class Out>
+    void subtract_blocks(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out, std::false_type) {
+        subtract_scalar(a, na, b, nb, out);
+    }
+
+    template<class T, class Out>
+    void subtract(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+        if(na * gallop_ratio < nb) {
+            const T* pos = b;
+            const T* const end = b + nb;
+            for(std::size_t idx = 0; idx != na; ++idx) {
+                pos = gallop(pos, end, a[idx]);
+                if(pos == end || *pos != a[idx]) out(a[idx]);
+            }
+            return;
+        }
+        if(nb * gallop_ratio < na) {
+            const T* pos = a;
+            const T* const end = a + na;
+            for(std::size_t idx = 0; idx != nb; ++idx) {
+                const T* next = gallop(pos, end, b[idx]);
+                append_run(pos, next, out);
+                pos = next;
+                if(pos != end && *pos == b[idx]) ++pos;
+            }
+            return append_run(pos, end, out);
+        }
+        subtract_blocks(a, na, b, nb, out, std::integral_constant<bool, sizeof(T) == 4>{});
+    }
+
+    struct intersect_algo {
+        template<class T, class Out>
+        static void run(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+            intersect(a, na, b, nb, out);
+        }
+    };
+    template<bool Merge>
+    struct unite_algo {
+        template<class T, class Out>
+        static void run(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+            unite<Merge>(a, na, b, nb, out);
+        }
+    };
+    struct subtract_algo {
+        template<class T, class Out>
+        static void run(const T* a, std::size_t na, const T* b, std::size_t nb, Out& out) {
+            subtract(a, na, b, nb, out);
+        }
+    };
+
+    // runs Algo with an unchecked appender if bound more elements fit in out and a checked one otherwise
+    template<class Algo, class T, std::size_t N, std::size_t M, std::size_t K>
+    void append_result(const inplace_vector<T, N>& a, const inplace_vector<T, M>& b, inplace_vector<T, K>& out, std::size_t bound) {
+        if(bound <= out.capacity() - out.size()) {
+            unchecked_append<T, K> app{out};
+            Algo::run(a.data(), a.size(), b.data(), b.size(), app);
+        } else {
+            checked_append<T, K> app{out};
+            Algo::run(a.data(), a.size(), b.data(), b.size(), app);
+        }
+    }
+} // namespace lyn_inplace_set_algorithm_detail
+
+template<class T, std::size_t N, std::size_t M, std::size_t K>
+typename std::enable_if<lyn_inplace_set_algorithm_detail::is_set_integer<T>::value>::type
+set_intersection(const inplace_vector<T, N>& a, const inplace_vector<T, M>& b, inplace_vector<T, K>& out) {
+    using namespace lyn_inplace_set_algorithm_detail;
+    append_result<intersect_algo>(a, b, out, std::min(a.size(), b.size()));
+}
+
+template<class T, std::size_t N, std::size_t M>
+typename std::enable_if<lyn_inplace_set_algorithm_detail::is_set_integer<T>::value, std::size_t>::type
+intersection_size(const inplace_vector<T, N>& a, const inplace_vector<T, M>& b) noexcept {
+    lyn_inplace_set_algorithm_detail::counter count{0};
+    lyn_inplace_set_algorithm_detail::intersect(a.data(), a.size(), b.data(), b.size(), count);
+    return count.count;
+}
+
+template<class T, std::size_t N, std::size_t M, std::size_t K>
+typename std::enable_if<lyn_inplace_set_algorithm_detail::is_set_integer<T>::value>::type
+set_union(const inplace_vector<T, N>& a, const inplace_vector<T, M>& b, inplace_vector<T, K>& out) {
+    using namespace lyn_inplace_set_algorithm_detail;
+    append_result<unite_algo<false>>(a, b, out, a.size() + b.size());
+}
+
+template<class T, std::size_t N, std::size_t M, std::size_t K>
+typename std::enable_if<lyn_inplace_set_algorithm_detail::is_set_integer<T>::value>::type
+set_difference(const inplace_vector<T, N>& a, const inplace_vector<T, M>& b, inplace_vector<T, K>& out) {
+    using namespace lyn_inplace_set_algorithm_detail;
+    append_result<subtract_algo>(a, b, out, a.size());
+}
+
+template<class T, std::size_t N, std::size_t M, std::size_t K>
+typename std::enable_if<lyn_inplace_set_algorithm_detail::is_set_integer<T>::value>::type
+merge(const inplace_vector<T, N>& a, const inplace_vector<T, M>& b, inplace_vector<T, K>& out) {
+    using namespace lyn_inplace_set_algorithm_detail;
+    append_result<unite_algo<true>>(a, b, out, a.size() + b.size());
+}
+
+} // namespace lyn
+
+#undef LYNIPV_HAS_SSE2
+
+#endif
@@ -0,0 +1,240 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_7FEEF75E_CB59_11F1_B96B_02FC00000001
+#define LYNIPV_7FEEF75E_CB59_11F1_B96B_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+// A handle to an element in an inplace_slot_map. It stays valid until the element is erased and is never
+// valid again after that, even if the slot is reused. A default constructed handle is never valid.
+struct inplace_slot_map_handle {
+    constexpr inplace_slot_map_handle() noexcept = default;
+    constexpr inplace_slot_map_handle(std::uint32_t idx, std::uint32_t gen) noexcept : index(idx), generation(gen) {}
+
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0; // odd while the slot is occupied
+
+    friend bool operator==(const inplace_slot_map_handle& lhs, const inplace_slot_map_handle& rhs) noexcept {
+        return lhs.index == rhs.index && lhs.generation == rhs.generation;
+    }
+    friend bool operator!=(const inplace_slot_map_handle& lhs, const inplace_slot_map_handle& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+};
+
+// Values are kept densely packed in an inplace_vector for fast iteration. Handles refer to slots in an
+// indirection table which in turn point at the values. Erasing moves the last value into the hole, so the
+// order of the values is not preserved, but the handles of all other values are.
+template<class T, std::size_t N>
+class inplace_slot_map {
+    static_assert(N != 0, "inplace_slot_map: N must be greater than zero");
+    static_assert(N < 0xFFFFFFFF, "inplace_slot_map: N is too large");
+
+    struct slot {
+        std::uint32_t index;      // into the dense values while occupied, the next free slot otherwise
+        std::uint32_t generation; // bumped on insert and erase, so odd means occupied
+    };
+
+public:
+    using handle = inplace_slot_map_handle;
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using iterator = typename inplace_vector<T, N>::iterator;
+    using const_iterator = typename inplace_vector<T, N>::const_iterator;
+
+    inplace_slot_map() = default;
+    inplace_slot_map(const inplace_slot_map& other) : m_values(other.m_values) { copy_indices(other); }
+    inplace_slot_map(inplace_slot_map&& other) noexcept(std::is_nothrow_move_constructible<T>::value) :
+        m_values(std::move(other.m_values)) {
+        copy_indices(other);
+        other.free_slots(m_values.size());
+    }
+    inplace_slot_map& operator=(const inplace_slot_map& other) {
+        if(this != &other) {
+            m_values = other.m_values;
+            copy_indices(other);
+        }
+        return *this;
+    }
+    inplace_slot_map& operator=(inplace_slot_map&& other) noexcept(std::is_nothrow_move_assignable<T>::value &&
+                                                                   std::is_nothrow_move_constructible<T>::value) {
+        if(this != &other) {
+            m_values = std::move(other.m_values);
+            copy_indices(other);
+            other.free_slots(m_values.size());
+        }
+        return *this;
+    }
+
+    // lookup
+    bool contains(handle hnd) const noexcept { return hnd.index < m_unused && m_slots[hnd.index].generation == hnd.generation; }
+    pointer find(handle hnd) noexcept { return contains(hnd) ? m_values.data() + m_slots[hnd.index].index : nullptr; }
+    const_pointer find(handle hnd) const noexcept {
+        return contains(hnd) ? m_values.data() + m_slots[hnd.index].index : nullptr;
+    }
+    // precondition: contains(hnd)
+    reference operator[](handle hnd) noexcept { return m_values[m_slots[hnd.index].index]; }
+    const_reference operator[](handle hnd) const noexcept { return m_values[m_slots[hnd.index].index]; }
+    reference at(handle hnd) {
+        if(!contains(hnd)) lyn_inplace_vector_detail::throw_out_of_range();
+        return (*this)[hnd];
+    }
+    const_reference at(handle hnd) const {
+        if(!contains(hnd)) lyn_inplace_vector_detail::throw_out_of_range();
+        return (*this)[hnd];
+    }
+
+    // the handle of the value at position pos in the dense values
+    handle handle_of(const_iterator pos) const noexcept {
+        auto slot_idx = m_dense_to_slot[static_cast<size_type>(pos - begin())];
+        return handle{slot_idx, m_slots[slot_idx].generation};
+    }
+
+    // iteration over the dense values, in no particular order
+    iterator begin() noexcept { return m_values.begin(); }
+    iterator end() noexcept { return m_values.end(); }
+    const_iterator begin() const noexcept { return m_values.begin(); }
+    const_iterator end() const noexcept { return m_values.end(); }
+    const_iterator cbegin() const noexcept { return m_values.cbegin(); }
+    const_iterator cend() const noexcept { return m_values.cend(); }
+    pointer data() noexcept { return m_values.data(); }
+    const_pointer data() const noexcept { return m_values.data(); }
+
+    // size and capacity
+    bool empty() const noexcept { return m_values.empty(); }
+    bool full() const noexcept { return m_values.size() == N; }
+    size_type size() const noexcept { return m_values.size(); }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // modifiers
+    template<class... Args>
+    handle emplace(Args&&... args) {
+        if(full()) lyn_inplace_vector_detail::throw_bad_alloc();
+        return unchecked_emplace(std::forward<Args>(args)...);
+    }
+    handle insert(const T& value) { return emplace(value); }
+    handle insert(T&& value) { return emplace(std::move(value)); }
+
+    // second is false, and nothing is constructed, if the map is full
+    template<class... Args>
+    std::pair<handle, bool> try_emplace(Args&&... args) {
+        if(full()) return {handle{}, false};
+        return {unchecked_emplace(std::forward<Args>(args)...), true};
+    }
+
+    // returns false if hnd did not refer to an element
+    bool erase(handle hnd) noexcept {
+        if(!contains(hnd)) return false;
+        auto& victim = m_slots[hnd.index];
+        const auto last = static_cast<std::uint32_t>(m_values.size() - 1);
+        if(victim.index != last) {
+            m_values[victim.index] = std::move(m_values[last]);
+            m_dense_to_slot[victim.index] = m_dense_to_slot[last];
+            m_slots[m_dense_to_slot[last]].index = victim.index;
+        }
+        m_values.pop_back();
+        ++victim.generation;
+        victim.index = m_free;
+        m_free = hnd.index;
+        return true;
+    }
+
+    // invalidates all handles
+    void clear() noexcept { free_slots(m_values.size()); }
+
+private:
+    // Copies the initialized parts of the index arrays, after the values have been copied or moved.
+    void copy_indices(const inplace_slot_map& other) noexcept {
+        std::copy_n(other.m_dense_to_slot.begin(), m_values.size(), m_dense_to_slot.begin());
+        std::copy_n(other.m_slots.begin(), other.m_unused, m_slots.begin());
+        m_free = other.m_free;
+        m_unused = other.m_unused;
+    }
+
+    // Frees the slots of the first count dense values and clears the values. count is passed in since a
+    // moved-from inplace_vector may already be empty.
+    void free_slots(size_type count) noexcept {
+        for(size_type idx = 0; idx != count; ++idx) {
+            auto slot_idx = m_dense_to_slot[idx];
+            ++m_slots[slot_idx].generation;
+            m_slots[slot_idx].index = m_free;
+            m_free = slot_idx;
+        }
+        m_values.clear();
+    }
+
+    static constexpr std::uint32_t no_slot = static_cast<std::uint32_t>(N);
+
+    // slots that have been used before are reused first, so that generations keep growing
+    template<class... Args>
+    handle unchecked_emplace(Args&&... args) {
+        const auto slot_idx = m_free != no_slot ? m_free : m_unused;
+        const auto dense_idx = static_cast<std::uint32_t>(m_values.size());
+        m_values.unchecked_emplace_back(std::forward<Args>(args)...);
+        m_dense_to_slot[dense_idx] = slot_idx;
+        auto& slt = m_slots[slot_idx];
+        if(slot_idx == m_free) {
+            m_free = slt.index;
+            ++slt.generation;
+        } else {
+            ++m_unused;
+            slt.generation = 1;
+        }
+        slt.index = dense_idx;
+        return handle{slot_idx, slt.generation};
+    }
+
+    inplace_vector<T, N> m_values;
+    std::array<std::uint32_t, N> m_dense_to_slot; // the entries from size() and on are uninitialized
+    std::array<slot, N> m_slots; // the slots from m_unused and on are uninitialized
+    std::uint32_t m_free = no_slot;
+    std::uint32_t m_unused = 0;
+};
+
+template<class T, std::size_t N>
+constexpr std::uint32_t inplace_slot_map<T, N>::no_slot;
+
+} // namespace lyn
+
+#endif
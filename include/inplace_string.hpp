@@ -0,0 +1,427 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_CDF8F32E_CB58_11F1_A45E_02FC00000001
+#define LYNIPV_CDF8F32E_CB58_11F1_A45E_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#if __cplusplus >= 201703L
+# include <string_view>
+#endif
+#if __cplusplus >= 202002L
+# include <compare>
+#endif
+
+namespace lyn {
+
+namespace lyn_inplace_string_detail {
+    template<class CharT>
+    using uchar_t = typename std::make_unsigned<CharT>::type;
+
+    // When N fits in a CharT, the remaining capacity, N - size(), is kept in the last element of the
+    // buffer. It is zero when the string is full and then doubles as the null terminator.
+    template<class CharT, std::size_t N>
+    struct compact_storage {
+        std::size_t size() const noexcept { return N - static_cast<uchar_t<CharT>>(m_data[N]); }
+        void set_size(std::size_t count) noexcept {
+            m_data[count] = CharT();
+            m_data[N] = static_cast<CharT>(static_cast<uchar_t<CharT>>(N - count));
+        }
+
+        CharT m_data[N + 1];
+    };
+
+    template<class CharT, std::size_t N>
+    struct separate_storage {
+        std::size_t size() const noexcept { return m_size; }
+        void set_size(std::size_t count) noexcept {
+            m_data[count] = CharT();
+            m_size = count;
+        }
+
+        CharT m_data[N + 1];
+        std::size_t m_size;
+    };
+
+    template<class CharT, std::size_t N>
+    struct storage_selector :
+        std::conditional<(N <= std::numeric_limits<uchar_t<CharT>>::max()), compact_storage<CharT, N>,
+                         separate_storage<CharT, N>> {};
+
+    template<class CharT, class Traits>
+    struct has_std_hash :
+        std::integral_constant<bool, std::is_same<Traits, std::char_traits<CharT>>::value &&
+                                         (std::is_same<CharT, char>::value || std::is_same<CharT, wchar_t>::value ||
+#if defined(__cpp_char8_t)
+                                          std::is_same<CharT, char8_t>::value ||
+#endif
+                                          std::is_same<CharT, char16_t>::value || std::is_same<CharT, char32_t>::value)> {};
+
+    // FNV-1a, used where the standard library has no hash for the string's character type and traits
+    template<class CharT>
+    std::size_t fnv1a(const CharT* str, std::size_t count) noexcept {
+        std::uint64_t hash = 14695981039346656037ULL;
+        auto bytes = reinterpret_cast<const unsigned char*>(str);
+        for(std::size_t idx = 0; idx != count * sizeof(CharT); ++idx) {
+            hash = (hash ^ bytes[idx]) * 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+} // namespace lyn_inplace_string_detail
+
+// A null terminated string with the characters stored in the object itself. Operations that would make
+// the string longer than N characters throw std::bad_alloc, just like inplace_vector.
+template<class CharT, std::size_t N, class Traits = std::char_traits<CharT>>
+class basic_inplace_string {
+    static_assert(std::is_same<CharT, typename Traits::char_type>::value, "basic_inplace_string: Traits::char_type must be CharT");
+
+public:
+    using traits_type = Traits;
+    using value_type = CharT;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = CharT&;
+    using const_reference = CharT const&;
+    using pointer = CharT*;
+    using const_pointer = CharT const*;
+    using iterator = CharT*;
+    using const_iterator = CharT const*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+#if __cplusplus >= 201703L
+    using string_view_type = std::basic_string_view<CharT, Traits>;
+#endif
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // constructors
+    basic_inplace_string() noexcept { m_store.set_size(0); }
+    basic_inplace_string(const CharT* str) { assign(str); }
+    basic_inplace_string(const CharT* str, size_type count) { assign(str, count); }
+    basic_inplace_string(size_type count, CharT ch) { assign(count, ch); }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    basic_inplace_string(InputIt first, InputIt last) {
+        assign(first, last);
+    }
+    basic_inplace_string(std::initializer_list<CharT> ilist) { assign(ilist.begin(), ilist.size()); }
+    template<class Alloc>
+    explicit basic_inplace_string(const std::basic_string<CharT, Traits, Alloc>& str) {
+        assign(str.data(), str.size());
+    }
+#if __cplusplus >= 201703L
+    explicit basic_inplace_string(string_view_type sv) { assign(sv.data(), sv.size()); }
+#endif
+
+    // assignment
+    basic_inplace_string& operator=(const CharT* str) { return assign(str); }
+    basic_inplace_string& operator=(CharT ch) { return assign(1, ch); }
+    basic_inplace_string& operator=(std::initializer_list<CharT> ilist) { return assign(ilist.begin(), ilist.size()); }
+#if __cplusplus >= 201703L
+    basic_inplace_string& operator=(string_view_type sv) { return assign(sv.data(), sv.size()); }
+#endif
+
+    basic_inplace_string& assign(const CharT* str, size_type count) {
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        Traits::move(data(), str, count); // str may point into *this
+        m_store.set_size(count);
+        return *this;
+    }
+    basic_inplace_string& assign(const CharT* str) { return assign(str, Traits::length(str)); }
+    basic_inplace_string& assign(size_type count, CharT ch) {
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        Traits::assign(data(), count, ch);
+        m_store.set_size(count);
+        return *this;
+    }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    basic_inplace_string& assign(InputIt first, InputIt last) {
+        clear();
+        for(; first != last; ++first) push_back(*first);
+        return *this;
+    }
+#if __cplusplus >= 201703L
+    basic_inplace_string& assign(string_view_type sv) { return assign(sv.data(), sv.size()); }
+#endif
+
+    // element access
+    reference operator[](size_type idx) noexcept { return m_store.m_data[idx]; }
+    const_reference operator[](size_type idx) const noexcept { return m_store.m_data[idx]; }
+    reference at(size_type idx) {
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
+        return m_store.m_data[idx];
+    }
+    const_reference at(size_type idx) const {
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
+        return m_store.m_data[idx];
+    }
+    reference front() noexcept { return m_store.m_data[0]; }
+    const_reference front() const noexcept { return m_store.m_data[0]; }
+    reference back() noexcept { return m_store.m_data[size() - 1]; }
+    const_reference back() const noexcept { return m_store.m_data[size() - 1]; }
+
+    pointer data() noexcept { return m_store.m_data; }
+    const_pointer data() const noexcept { return m_store.m_data; }
+    const_pointer c_str() const noexcept { return m_store.m_data; }
+
+#if __cplusplus >= 201703L
+    operator string_view_type() const noexcept { return string_view_type(data(), size()); }
+#endif
+
+    // iterators
+    const_iterator cbegin() const noexcept { return data(); }
+    const_iterator cend() const noexcept { return data() + size(); }
+    const_iterator begin() const noexcept { return cbegin(); }
+    const_iterator end() const noexcept { return cend(); }
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size(); }
+
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+    const_reverse_iterator rbegin() const noexcept { return crbegin(); }
+    const_reverse_iterator rend() const noexcept { return crend(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    // size and capacity
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept { return m_store.size(); }
+    size_type length() const noexcept { return size(); }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // modifiers
+    void clear() noexcept { m_store.set_size(0); }
+
+    void push_back(CharT ch) {
+        auto count = size();
+        if(count == N) lyn_inplace_vector_detail::throw_bad_alloc();
+        m_store.m_data[count] = ch;
+        m_store.set_size(count + 1);
+    }
+    void pop_back() noexcept { m_store.set_size(size() - 1); }
+
+    basic_inplace_string& append(const CharT* str, size_type count) {
+        if(!try_append(str, count)) lyn_inplace_vector_detail::throw_bad_alloc();
+        return *this;
+    }
+    basic_inplace_string& append(const CharT* str) { return append(str, Traits::length(str)); }
+    basic_inplace_string& append(size_type count, CharT ch) {
+        auto old = size();
+        if(count > N - old) lyn_inplace_vector_detail::throw_bad_alloc();
+        Traits::assign(data() + old, count, ch);
+        m_store.set_size(old + count);
+        return *this;
+    }
+    template<std::size_t M>
+    basic_inplace_string& append(const basic_inplace_string<CharT, M, Traits>& str) {
+        return append(str.data(), str.size());
+    }
+#if __cplusplus >= 201703L
+    basic_inplace_string& append(string_view_type sv) { return append(sv.data(), sv.size()); }
+#endif
+
+    // appends all or nothing and returns true if the characters fit
+    bool try_append(const CharT* str, size_type count) noexcept {
+        auto old = size();
+        if(count > N - old) return false;
+        Traits::move(data() + old, str, count); // str may point into *this
+        m_store.set_size(old + count);
+        return true;
+    }
+
+    basic_inplace_string& operator+=(CharT ch) {
+        push_back(ch);
+        return *this;
+    }
+    basic_inplace_string& operator+=(const CharT* str) { return append(str); }
+    template<std::size_t M>
+    basic_inplace_string& operator+=(const basic_inplace_string<CharT, M, Traits>& str) {
+        return append(str.data(), str.size());
+    }
+#if __cplusplus >= 201703L
+    basic_inplace_string& operator+=(string_view_type sv) { return append(sv.data(), sv.size()); }
+#endif
+
+    void resize(size_type count, CharT ch) {
+        auto old = size();
+        if(count > old) {
+            append(count - old, ch);
+        } else {
+            m_store.set_size(count);
+        }
+    }
+    void resize(size_type count) { resize(count, CharT()); }
+
+    // search
+    size_type find(const CharT* str, size_type pos, size_type count) const noexcept {
+        const auto len = size();
+        if(count == 0) return pos <= len ? pos : npos;
+        if(pos >= len || count > len - pos) return npos;
+        const CharT* const first = data();
+        const CharT* const last = first + len - count + 1;
+        for(auto it = first + pos; it != last; ++it) {
+            it = Traits::find(it, static_cast<size_type>(last - it), *str);
+            if(!it) break;
+            if(Traits::compare(it, str, count) == 0) return static_cast<size_type>(it - first);
+        }
+        return npos;
+    }
+    size_type find(const CharT* str, size_type pos = 0) const noexcept { return find(str, pos, Traits::length(str)); }
+    size_type find(CharT ch, size_type pos = 0) const noexcept {
+        const auto len = size();
+        if(pos >= len) return npos;
+        auto it = Traits::find(data() + pos, len - pos, ch);
+        return it ? static_cast<size_type>(it - data()) : npos;
+    }
+    template<std::size_t M>
+    size_type find(const basic_inplace_string<CharT, M, Traits>& str, size_type pos = 0) const noexcept {
+        return find(str.data(), pos, str.size());
+    }
+
+    size_type rfind(const CharT* str, size_type pos, size_type count) const noexcept {
+        const auto len = size();
+        if(count > len) return npos;
+        for(auto idx = std::min(pos, len - count) + 1; idx-- != 0;) {
+            if(Traits::compare(data() + idx, str, count) == 0) return idx;
+        }
+        return npos;
+    }
+    size_type rfind(const CharT* str, size_type pos = npos) const noexcept { return rfind(str, pos, Traits::length(str)); }
+    size_type rfind(CharT ch, size_type pos = npos) const noexcept { return rfind(&ch, pos, 1); }
+
+    // comparisons
+    int compare(const CharT* str, size_type count) const noexcept {
+        const auto len = size();
+        auto rv = Traits::compare(data(), str, std::min(len, count));
+        if(rv != 0) return rv;
+        return len < count ? -1 : (len > count ? 1 : 0);
+    }
+    int compare(const CharT* str) const noexcept { return compare(str, Traits::length(str)); }
+    template<std::size_t M>
+    int compare(const basic_inplace_string<CharT, M, Traits>& str) const noexcept {
+        return compare(str.data(), str.size());
+    }
+
+    template<std::size_t M>
+    friend bool operator==(const basic_inplace_string& lhs, const basic_inplace_string<CharT, M, Traits>& rhs) noexcept {
+        return lhs.size() == rhs.size() && Traits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+    }
+    friend bool operator==(const basic_inplace_string& lhs, const CharT* rhs) noexcept { return lhs.compare(rhs) == 0; }
+#if __cplusplus >= 202002L
+    template<std::size_t M>
+    friend std::strong_ordering operator<=>(const basic_inplace_string& lhs,
+                                            const basic_inplace_string<CharT, M, Traits>& rhs) noexcept {
+        return lhs.compare(rhs) <=> 0;
+    }
+    friend std::strong_ordering operator<=>(const basic_inplace_string& lhs, const CharT* rhs) noexcept {
+        return lhs.compare(rhs) <=> 0;
+    }
+#else
+    friend bool operator==(const CharT* lhs, const basic_inplace_string& rhs) noexcept { return rhs.compare(lhs) == 0; }
+    template<std::size_t M>
+    friend bool operator!=(const basic_inplace_string& lhs, const basic_inplace_string<CharT, M, Traits>& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+    friend bool operator!=(const basic_inplace_string& lhs, const CharT* rhs) noexcept { return lhs.compare(rhs) != 0; }
+    friend bool operator!=(const CharT* lhs, const basic_inplace_string& rhs) noexcept { return rhs.compare(lhs) != 0; }
+    template<std::size_t M>
+    friend bool operator<(const basic_inplace_string& lhs, const basic_inplace_string<CharT, M, Traits>& rhs) noexcept {
+        return lhs.compare(rhs) < 0;
+    }
+    template<std::size_t M>
+    friend bool operator>(const basic_inplace_string& lhs, const basic_inplace_string<CharT, M, Traits>& rhs) noexcept {
+        return lhs.compare(rhs) > 0;
+    }
+    template<std::size_t M>
+    friend bool operator<=(const basic_inplace_string& lhs, const basic_inplace_string<CharT, M, Traits>& rhs) noexcept {
+        return lhs.compare(rhs) <= 0;
+    }
+    template<std::size_t M>
+    friend bool operator>=(const basic_inplace_string& lhs, const basic_inplace_string<CharT, M, Traits>& rhs) noexcept {
+        return lhs.compare(rhs) >= 0;
+    }
+#endif
+
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const basic_inplace_string& str) {
+        return os.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+    void swap(basic_inplace_string& other) noexcept { std::swap(m_store, other.m_store); }
+    friend void swap(basic_inplace_string& lhs, basic_inplace_string& rhs) noexcept { lhs.swap(rhs); }
+
+private:
+    typename lyn_inplace_string_detail::storage_selector<CharT, N>::type m_store;
+};
+
+template<class CharT, std::size_t N, class Traits>
+constexpr typename basic_inplace_string<CharT, N, Traits>::size_type basic_inplace_string<CharT, N, Traits>::npos;
+
+template<std::size_t N>
+using inplace_string = basic_inplace_string<char, N>;
+template<std::size_t N>
+using inplace_wstring = basic_inplace_string<wchar_t, N>;
+template<std::size_t N>
+using inplace_u16string = basic_inplace_string<char16_t, N>;
+template<std::size_t N>
+using inplace_u32string = basic_inplace_string<char32_t, N>;
+#if defined(__cpp_char8_t)
+template<std::size_t N>
+using inplace_u8string = basic_inplace_string<char8_t, N>;
+#endif
+
+} // namespace lyn
+
+// Where the standard library can hash the same characters as a std::basic_string_view, the hash is the same
+// as for std::basic_string and std::basic_string_view.
+namespace std {
+template<class CharT, std::size_t N, class Traits>
+struct hash<lyn::basic_inplace_string<CharT, N, Traits>> {
+    std::size_t operator()(const lyn::basic_inplace_string<CharT, N, Traits>& str) const noexcept {
+#if __cplusplus >= 201703L
+        if constexpr(lyn::lyn_inplace_string_detail::has_std_hash<CharT, Traits>::value) {
+            return std::hash<std::basic_string_view<CharT, Traits>>{}(str);
+        }
+#endif
+        return lyn::lyn_inplace_string_detail::fnv1a(str.data(), str.size());
+    }
+};
+} // namespace std
+
+#endif
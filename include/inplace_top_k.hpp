@@ -0,0 +1,212 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_02BC52E2_CB57_11F1_9A6F_02FC00000001
+#define LYNIPV_02BC52E2_CB57_11F1_9A6F_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+namespace lyn_inplace_top_k_detail {
+    // The batch offer() pre-filters blocks of this many elements against the current threshold
+    // before touching the heap. The block test is a branch free reduction that compilers turn
+    // into a handful of vector compares for arithmetic keys.
+    constexpr std::size_t prefilter_block = 16;
+
+    template<class T, class Compare>
+    struct is_builtin_compare :
+        std::integral_constant<bool, std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::greater<T>>::value
+#if __cplusplus >= 201402L
+                                         || std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::greater<>>::value
+#endif
+                               > {
+    };
+
+    template<class T, class Compare, class It>
+    struct can_prefilter :
+        std::integral_constant<bool, std::is_arithmetic<T>::value && is_builtin_compare<T, Compare>::value &&
+                                         std::is_base_of<std::random_access_iterator_tag,
+                                                         typename std::iterator_traits<It>::iterator_category>::value &&
+                                         std::is_same<T, typename std::iterator_traits<It>::value_type>::value> {};
+} // namespace lyn_inplace_top_k_detail
+
+// Keeps the K greatest elements, according to Compare, out of everything offered to it. The elements
+// are kept in a min-heap so that top() is the least of the retained elements, which is the threshold
+// a new element has to beat to get in.
+template<class T, std::size_t K, class Compare = std::less<T>>
+class inplace_top_k {
+    static_assert(K != 0, "inplace_top_k: K must be greater than zero");
+    static_assert(!std::is_const<T>::value, "inplace_top_k: T must not be const");
+
+public:
+    using container_type = inplace_vector<T, K>;
+    using value_compare = Compare;
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using const_iterator = typename container_type::const_iterator;
+
+    inplace_top_k() = default;
+    explicit inplace_top_k(const Compare& comp) : m_comp(comp) {}
+
+    // capacity
+    bool empty() const noexcept { return m_heap.empty(); }
+    bool full() const noexcept { return m_heap.size() == K; }
+    size_type size() const noexcept { return m_heap.size(); }
+    static constexpr size_type capacity() noexcept { return K; }
+
+    // the least of the retained elements - precondition: !empty()
+    const_reference top() const noexcept { return m_heap.front(); }
+
+    // the retained elements in heap order
+    const_iterator begin() const noexcept { return m_heap.begin(); }
+    const_iterator end() const noexcept { return m_heap.end(); }
+
+    value_compare value_comp() const { return m_comp; }
+
+    // Returns true if value was retained. When full, a value that does not beat top() is rejected
+    // with a single comparison.
+    bool offer(const T& value) {
+        if(full()) {
+            if(!m_comp(top(), value)) return false;
+            replace_top(value);
+        } else {
+            push(value);
+        }
+        return true;
+    }
+
+    bool offer(T&& value) {
+        if(full()) {
+            if(!m_comp(top(), value)) return false;
+            replace_top(std::move(value));
+        } else {
+            push(std::move(value));
+        }
+        return true;
+    }
+
+    // Offers all elements in [first, last) and returns how many of them that were retained at the time
+    // they were offered.
+    template<class InputIt>
+    size_type offer(InputIt first, InputIt last) {
+        return offer_range(first, last, lyn_inplace_top_k_detail::can_prefilter<T, Compare, InputIt>{});
+    }
+
+    // Replaces top() with value and restores the heap property, without comparing value to top().
+    // Precondition: !empty()
+    void replace_top(const T& value) { sift_down(T(value)); }
+    void replace_top(T&& value) { sift_down(std::move(value)); }
+
+    void clear() noexcept { m_heap.clear(); }
+
+    // Returns the retained elements, greatest first, and leaves *this empty.
+    container_type sorted_drain() {
+        std::sort_heap(m_heap.begin(), m_heap.end(), inverted{m_comp});
+        container_type rv(std::move(m_heap));
+        m_heap.clear();
+        return rv;
+    }
+
+private:
+    // The std heap algorithms build max-heaps. Inverting the comparison gives the min-heap we need.
+    struct inverted {
+        const Compare& comp;
+        bool operator()(const T& lhs, const T& rhs) const { return comp(rhs, lhs); }
+    };
+
+    template<class U>
+    void push(U&& value) {
+        m_heap.unchecked_push_back(std::forward<U>(value));
+        std::push_heap(m_heap.begin(), m_heap.end(), inverted{m_comp});
+    }
+
+    // moves the hole at the root down to where value belongs
+    void sift_down(T value) {
+        auto heap = m_heap.data();
+        const size_type count = m_heap.size();
+        size_type idx = 0;
+        for(size_type child = 1; child < count; child = 2 * idx + 1) {
+            if(child + 1 < count && m_comp(heap[child + 1], heap[child])) ++child;
+            if(!m_comp(heap[child], value)) break;
+            heap[idx] = std::move(heap[child]);
+            idx = child;
+        }
+        heap[idx] = std::move(value);
+    }
+
+    template<class InputIt>
+    size_type offer_range(InputIt first, InputIt last, std::false_type) {
+        size_type retained = 0;
+        for(; first != last; ++first) {
+            if(offer(*first)) ++retained;
+        }
+        return retained;
+    }
+
+    template<class RandomIt>
+    size_type offer_range(RandomIt first, RandomIt last, std::true_type) {
+        using lyn_inplace_top_k_detail::prefilter_block;
+        size_type retained = 0;
+        for(; first != last && !full(); ++first) {
+            push(*first);
+            ++retained;
+        }
+        while(static_cast<size_type>(last - first) >= prefilter_block) {
+            const T threshold = top();
+            unsigned hits = 0;
+            for(size_type idx = 0; idx != prefilter_block; ++idx) {
+                hits |= static_cast<unsigned>(m_comp(threshold, first[static_cast<std::ptrdiff_t>(idx)]));
+            }
+            if(hits) {
+                for(size_type idx = 0; idx != prefilter_block; ++idx) {
+                    if(offer(first[static_cast<std::ptrdiff_t>(idx)])) ++retained;
+                }
+            }
+            first += static_cast<std::ptrdiff_t>(prefilter_block);
+        }
+        return retained + offer_range(first, last, std::false_type{});
+    }
+
+    container_type m_heap;
+    Compare m_comp;
+};
+
+} // namespace lyn
+
+#endif
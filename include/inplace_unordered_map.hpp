@@ -0,0 +1,509 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_77A79F32_CB5A_11F1_85B6_02FC00000001
+#define LYNIPV_77A79F32_CB5A_11F1_85B6_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define LYNIPV_HAS_SSE2
+# include <emmintrin.h>
+#endif
+
+namespace lyn {
+
+namespace lyn_inplace_unordered_map_detail {
+    // A control byte is empty_ctrl for an empty bucket or the 7 low bits of the hash of the key in it.
+    constexpr unsigned char empty_ctrl = 0x80;
+    constexpr std::size_t group_width = 16;
+
+    // The smallest power of two holding N elements at a load factor of at most 7/8, and at least one
+    // group. It is always greater than N so a probe always reaches an empty bucket.
+    constexpr std::size_t bit_ceil(std::size_t value, std::size_t pow2 = 1) {
+        return pow2 >= value ? pow2 : bit_ceil(value, pow2 * 2);
+    }
+    constexpr std::size_t bucket_count(std::size_t N) {
+        return bit_ceil((N * 8 + 6) / 7) < group_width ? group_width : bit_ceil((N * 8 + 6) / 7);
+    }
+
+    // spreads weak hashes, like the identity hash of integers, over all bits
+    inline std::uint64_t mix(std::size_t hash) noexcept {
+        const std::uint64_t prod = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+        return prod ^ (prod >> 32);
+    }
+
+    // The control bytes of group_width consecutive buckets. Bit i in the returned masks is set if
+    // bucket i in the group matches.
+    struct group {
+#ifdef LYNIPV_HAS_SSE2
+        explicit group(const unsigned char* ctrl) noexcept : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+        unsigned match(unsigned char tag) const noexcept {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(static_cast<char>(tag)))));
+        }
+        unsigned match_empty() const noexcept { return static_cast<unsigned>(_mm_movemask_epi8(m_ctrl)); }
+
+    private:
+        __m128i m_ctrl;
+#else
+        explicit group(const unsigned char* ctrl) noexcept : m_ctrl(ctrl) {}
+        unsigned match(unsigned char tag) const noexcept {
+            unsigned bits = 0;
+            for(std::size_t idx = 0; idx != group_width; ++idx) bits |= static_cast<unsigned>(m_ctrl[idx] == tag) << idx;
+            return bits;
+        }
+        unsigned match_empty() const noexcept {
+            unsigned bits = 0;
+            for(std::size_t idx = 0; idx != group_width; ++idx) bits |= static_cast<unsigned>(m_ctrl[idx] >> 7) << idx;
+            return bits;
+        }
+
+    private:
+        const unsigned char* m_ctrl;
+#endif
+    };
+
+    // The storage of an element. Elements are constructed as value and handed out as std::pair<const Key, T>&.
+    // moving names the same pair with a mutable key, like the nodes of the standard unordered containers, and
+    // is only used to move an element that is destroyed right after to another bucket or container.
+    template<class Key, class T>
+    union node {
+        node() noexcept {}
+        ~node() {}
+
+        std::pair<const Key, T> value;
+        std::pair<Key, T> moving;
+    };
+} // namespace lyn_inplace_unordered_map_detail
+
+// An open addressing hash map storing up to N elements in the object itself. Buckets are probed linearly,
+// a group of 16 control bytes at a time, and erase shifts the following elements back instead of leaving
+// tombstones, so lookups never slow down with churn.
+//
+// Elements move when other elements are erased, so erase invalidates pointers and references to other
+// elements. Insertion does not move elements but may change the iteration order, so it invalidates
+// iterators. Erasing through an iterator returns an iterator that continues the iteration correctly.
+template<class Key, class T, std::size_t N, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class inplace_unordered_map {
+    static_assert(N != 0, "inplace_unordered_map: N must be greater than zero");
+    static_assert(std::is_nothrow_destructible<Key>::value && std::is_nothrow_destructible<T>::value,
+                  "inplace_unordered_map: classes with potentially throwing destructors are prohibited");
+    static_assert(std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<T>::value,
+                  "inplace_unordered_map: erase moves elements, so Key and T must be nothrow move constructible");
+
+    static constexpr std::size_t buckets = lyn_inplace_unordered_map_detail::bucket_count(N);
+    static constexpr std::size_t mask = buckets - 1;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+private:
+    using node = lyn_inplace_unordered_map_detail::node<Key, T>;
+
+    template<bool Const>
+    class basic_iterator {
+        using map_ptr = typename std::conditional<Const, const inplace_unordered_map*, inplace_unordered_map*>::type;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename inplace_unordered_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const value_type*, value_type*>::type;
+        using reference = typename std::conditional<Const, const value_type&, value_type&>::type;
+
+        basic_iterator() = default;
+        template<bool C = Const, typename std::enable_if<C, int>::type = 0>
+        basic_iterator(const basic_iterator<false>& other) noexcept : m_map(other.m_map), m_idx(other.m_idx) {}
+
+        reference operator*() const noexcept { return *m_map->ptr(m_idx); }
+        pointer operator->() const noexcept { return m_map->ptr(m_idx); }
+
+        basic_iterator& operator++() noexcept {
+            m_idx = m_map->next_full(m_idx);
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto rv = *this;
+            ++*this;
+            return rv;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx == rhs.m_idx; }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx != rhs.m_idx; }
+
+    private:
+        friend class inplace_unordered_map;
+        template<bool>
+        friend class basic_iterator;
+        basic_iterator(map_ptr map, size_type idx) noexcept : m_map(map), m_idx(idx) {}
+
+        map_ptr m_map = nullptr;
+        size_type m_idx = buckets;
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // constructors
+    inplace_unordered_map() : inplace_unordered_map(Hash(), KeyEqual()) {}
+    explicit inplace_unordered_map(const Hash& hash, const KeyEqual& equal = KeyEqual()) : m_hash(hash), m_equal(equal) {
+        std::memset(m_ctrl, lyn_inplace_unordered_map_detail::empty_ctrl, sizeof m_ctrl);
+    }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    inplace_unordered_map(InputIt first, InputIt last) : inplace_unordered_map() {
+        insert(first, last);
+    }
+    inplace_unordered_map(std::initializer_list<value_type> ilist) : inplace_unordered_map(ilist.begin(), ilist.end()) {}
+
+    // Copies keep the bucket layout of the source so nothing is rehashed.
+    inplace_unordered_map(const inplace_unordered_map& other) : inplace_unordered_map(other.m_hash, other.m_equal) {
+        copy_from(other);
+    }
+    inplace_unordered_map(inplace_unordered_map&& other) noexcept(std::is_nothrow_copy_constructible<Hash>::value &&
+                                                                 std::is_nothrow_copy_constructible<KeyEqual>::value) :
+        inplace_unordered_map(other.m_hash, other.m_equal) {
+        copy_from(other);
+        other.clear();
+    }
+    ~inplace_unordered_map() { clear(); }
+
+    // assignment
+    inplace_unordered_map& operator=(const inplace_unordered_map& other) {
+        if(this != &other) {
+            clear();
+            m_hash = other.m_hash;
+            m_equal = other.m_equal;
+            copy_from(other);
+        }
+        return *this;
+    }
+    inplace_unordered_map& operator=(inplace_unordered_map&& other) noexcept(std::is_nothrow_copy_assignable<Hash>::value &&
+                                                                            std::is_nothrow_copy_assignable<KeyEqual>::value) {
+        if(this != &other) {
+            clear();
+            m_hash = other.m_hash;
+            m_equal = other.m_equal;
+            copy_from(other);
+            other.clear();
+        }
+        return *this;
+    }
+    inplace_unordered_map& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    // iterators
+    iterator begin() noexcept { return iterator(this, next_full(m_origin)); }
+    iterator end() noexcept { return iterator(this, buckets); }
+    const_iterator begin() const noexcept { return const_iterator(this, next_full(m_origin)); }
+    const_iterator end() const noexcept { return const_iterator(this, buckets); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // size and capacity
+    bool empty() const noexcept { return m_size == 0; }
+    bool full() const noexcept { return m_size == N; }
+    size_type size() const noexcept { return m_size; }
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+    static constexpr size_type bucket_count() noexcept { return buckets; }
+    float load_factor() const noexcept { return static_cast<float>(m_size) / static_cast<float>(buckets); }
+
+    // lookup
+    iterator find(const Key& key) { return iterator(this, find_index(key, hash_of(key))); }
+    const_iterator find(const Key& key) const { return const_iterator(this, find_index(key, hash_of(key))); }
+    bool contains(const Key& key) const { return find_index(key, hash_of(key)) != buckets; }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    T& at(const Key& key) {
+        auto idx = find_index(key, hash_of(key));
+        if(idx == buckets) lyn_inplace_vector_detail::throw_out_of_range();
+        return ptr(idx)->second;
+    }
+    const T& at(const Key& key) const {
+        auto idx = find_index(key, hash_of(key));
+        if(idx == buckets) lyn_inplace_vector_detail::throw_out_of_range();
+        return ptr(idx)->second;
+    }
+    T& operator[](const Key& key) { return emplace_key(key).first->second; }
+    T& operator[](Key&& key) { return emplace_key(std::move(key)).first->second; }
+
+    // modifiers
+
+    // If key is not present and the map is full, nothing is constructed and {end(), false} is returned.
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return try_emplace_key(key, std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        return try_emplace_key(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // These throw std::bad_alloc if the key is not present and the map is full.
+    std::pair<iterator, bool> insert(const value_type& value) { return emplace_key(value.first, value.second); }
+    std::pair<iterator, bool> insert(value_type&& value) { return emplace_key(value.first, std::move(value.second)); }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void insert(InputIt first, InputIt last) {
+        for(; first != last; ++first) insert(*first);
+    }
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        auto rv = emplace_key(key, std::forward<M>(obj));
+        if(!rv.second) rv.first->second = std::forward<M>(obj);
+        return rv;
+    }
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+        auto rv = emplace_key(std::move(key), std::forward<M>(obj));
+        if(!rv.second) rv.first->second = std::forward<M>(obj);
+        return rv;
+    }
+
+    // Returns an iterator to the element that followed pos in the iteration.
+    iterator erase(const_iterator pos) {
+        erase_index(pos.m_idx);
+        return iterator(this, ctrl_full(pos.m_idx) ? pos.m_idx : next_full(pos.m_idx));
+    }
+    size_type erase(const Key& key) {
+        auto idx = find_index(key, hash_of(key));
+        if(idx == buckets) return 0;
+        erase_index(idx);
+        return 1;
+    }
+
+    void clear() noexcept {
+        if(!std::is_trivially_destructible<value_type>::value) {
+            for(size_type idx = 0; idx != buckets; ++idx) {
+                if(ctrl_full(idx)) ptr(idx)->~value_type();
+            }
+        }
+        std::memset(m_ctrl, lyn_inplace_unordered_map_detail::empty_ctrl, sizeof m_ctrl);
+        m_origin = 0;
+        m_size = 0;
+    }
+
+    void swap(inplace_unordered_map& other) noexcept(std::is_nothrow_move_constructible<inplace_unordered_map>::value &&
+                                                     std::is_nothrow_move_assignable<inplace_unordered_map>::value) {
+        inplace_unordered_map tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+    friend void swap(inplace_unordered_map& lhs, inplace_unordered_map& rhs) noexcept(noexcept(lhs.swap(rhs))) { lhs.swap(rhs); }
+
+    // observers
+    hasher hash_function() const { return m_hash; }
+    key_equal key_eq() const { return m_equal; }
+
+    friend bool operator==(const inplace_unordered_map& lhs, const inplace_unordered_map& rhs) {
+        if(lhs.size() != rhs.size()) return false;
+        for(auto& value : lhs) {
+            auto it = rhs.find(value.first);
+            if(it == rhs.end() || !(it->second == value.second)) return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const inplace_unordered_map& lhs, const inplace_unordered_map& rhs) { return !(lhs == rhs); }
+
+    // Erases the elements satisfying pred and returns how many they were.
+    template<class Pred>
+    friend size_type erase_if(inplace_unordered_map& map, Pred pred) {
+        size_type erased = 0;
+        for(auto it = map.begin(); it != map.end();) {
+            if(pred(*it)) {
+                it = map.erase(it);
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+        return erased;
+    }
+
+private:
+    value_type* ptr(size_type idx) noexcept { return lyn_inplace_vector_detail::launder(&m_slots[idx].value); }
+    const value_type* ptr(size_type idx) const noexcept { return lyn_inplace_vector_detail::launder(&m_slots[idx].value); }
+
+    std::uint64_t hash_of(const Key& key) const { return lyn_inplace_unordered_map_detail::mix(m_hash(key)); }
+    static size_type home_of(std::uint64_t hash) noexcept { return static_cast<size_type>(hash >> 7) & mask; }
+    static unsigned char tag_of(std::uint64_t hash) noexcept { return static_cast<unsigned char>(hash & 0x7F); }
+
+    bool ctrl_full(size_type idx) const noexcept { return !(m_ctrl[idx] & lyn_inplace_unordered_map_detail::empty_ctrl); }
+
+    // The first group_width control bytes are mirrored after the last bucket so that a group can be loaded
+    // from any bucket without wrapping.
+    void set_ctrl(size_type idx, unsigned char ctrl) noexcept {
+        m_ctrl[idx] = ctrl;
+        if(idx < lyn_inplace_unordered_map_detail::group_width) m_ctrl[buckets + idx] = ctrl;
+    }
+
+    // Iteration starts after m_origin, which is always an empty bucket. Elements shifted back by an erase
+    // stay within their run of full buckets, which never spans m_origin, so they are not visited twice.
+    size_type next_full(size_type idx) const noexcept {
+        for(idx = (idx + 1) & mask; idx != m_origin; idx = (idx + 1) & mask) {
+            if(ctrl_full(idx)) return idx;
+        }
+        return buckets;
+    }
+
+    size_type find_empty(size_type pos) const noexcept {
+        using namespace lyn_inplace_unordered_map_detail;
+        for(;; pos = (pos + group_width) & mask) {
+            if(auto bits = group(m_ctrl + pos).match_empty()) return (pos + lyn_inplace_vector_detail::countr_zero(bits)) & mask;
+        }
+    }
+
+    // Returns buckets if key is not present. An element is always found before the first empty bucket
+    // following its home bucket.
+    size_type find_index(const Key& key, std::uint64_t hash) const {
+        using namespace lyn_inplace_unordered_map_detail;
+        const auto tag = tag_of(hash);
+        for(size_type pos = home_of(hash);; pos = (pos + group_width) & mask) {
+            const group grp(m_ctrl + pos);
+            for(auto bits = grp.match(tag); bits; bits &= bits - 1) {
+                auto idx = (pos + lyn_inplace_vector_detail::countr_zero(bits)) & mask;
+                if(m_equal(ptr(idx)->first, key)) return idx;
+            }
+            if(grp.match_empty()) return buckets;
+        }
+    }
+
+    // precondition: the key is not present and !full()
+    template<class... Args>
+    size_type unchecked_emplace(std::uint64_t hash, Args&&... args) {
+        const auto idx = find_empty(home_of(hash));
+        ::new(static_cast<void*>(&m_slots[idx].value)) value_type(std::forward<Args>(args)...);
+        set_ctrl(idx, tag_of(hash));
+        ++m_size;
+        if(idx == m_origin) m_origin = find_empty(idx);
+        return idx;
+    }
+
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace_key(K&& key, Args&&... args) {
+        const auto hash = hash_of(key);
+        auto idx = find_index(key, hash);
+        if(idx != buckets) return {iterator(this, idx), false};
+        if(full()) return {end(), false};
+        idx = unchecked_emplace(hash, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(this, idx), true};
+    }
+
+    template<class K, class... Args>
+    std::pair<iterator, bool> emplace_key(K&& key, Args&&... args) {
+        auto rv = try_emplace_key(std::forward<K>(key), std::forward<Args>(args)...);
+        if(rv.first == end()) lyn_inplace_vector_detail::throw_bad_alloc();
+        return rv;
+    }
+
+    void relocate(size_type to, size_type from) noexcept {
+        construct_from(to, m_slots[from]);
+        ptr(from)->~value_type();
+    }
+
+    // Backward shift deletion: elements after the hole that may legally live in it are moved back until
+    // an empty bucket is reached.
+    void erase_index(size_type hole) {
+        ptr(hole)->~value_type();
+        for(size_type idx = (hole + 1) & mask; ctrl_full(idx); idx = (idx + 1) & mask) {
+            const auto home = home_of(hash_of(ptr(idx)->first));
+            if(((idx - home) & mask) >= ((idx - hole) & mask)) {
+                relocate(hole, idx);
+                set_ctrl(hole, m_ctrl[idx]);
+                hole = idx;
+            }
+        }
+        set_ctrl(hole, lyn_inplace_unordered_map_detail::empty_ctrl);
+        --m_size;
+    }
+
+    // Other is const when copying and the source of a move otherwise.
+    template<class Map>
+    void copy_from(Map& other) {
+        for(size_type idx = 0; idx != buckets; ++idx) {
+            if(other.ctrl_full(idx)) {
+                construct_from(idx, other.m_slots[idx]);
+                set_ctrl(idx, other.m_ctrl[idx]);
+                ++m_size;
+            }
+        }
+        m_origin = other.m_origin;
+    }
+    void construct_from(size_type idx, const node& src) {
+        ::new(static_cast<void*>(&m_slots[idx].value)) value_type(*lyn_inplace_vector_detail::launder(&src.value));
+    }
+    // the source is destroyed right after, so the key is moved too
+    void construct_from(size_type idx, node& src) noexcept {
+        ::new(static_cast<void*>(&m_slots[idx].value)) value_type(std::move(src.moving.first), std::move(src.moving.second));
+    }
+
+    node m_slots[buckets];
+    unsigned char m_ctrl[buckets + lyn_inplace_unordered_map_detail::group_width];
+    size_type m_origin = 0;
+    size_type m_size = 0;
+    Hash m_hash;
+    KeyEqual m_equal;
+};
+
+template<class Key, class T, std::size_t N, class Hash, class KeyEqual>
+constexpr std::size_t inplace_unordered_map<Key, T, N, Hash, KeyEqual>::buckets;
+template<class Key, class T, std::size_t N, class Hash, class KeyEqual>
+constexpr std::size_t inplace_unordered_map<Key, T, N, Hash, KeyEqual>::mask;
+
+} // namespace lyn
+
+#undef LYNIPV_HAS_SSE2
+
+#endif
@@ -32,6 +32,7 @@ For more information, please refer to <https://unlicense.org>
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -40,20 +41,81 @@ For more information, please refer to <https://unlicense.org>
 #include <iterator>
 #include <memory>
 #include <new>
-#include <stdexcept>
 #include <type_traits>
 #include <utility>
+
+#if !defined(LYNIPV_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+# define LYNIPV_NO_EXCEPTIONS
+#endif
+#ifdef LYNIPV_NO_EXCEPTIONS
+# include <atomic>
+# include <cstdlib>
+# include <exception>
+#else
+# include <stdexcept>
+#endif
 #if __cplusplus >= 202002L
 # include <compare>
 # include <ranges>
 #endif
+#if defined(__AVX512F__)
+# define LYNIPV_HAS_AVX512F
+#elif defined(__AVX2__)
+# define LYNIPV_HAS_AVX2
+#endif
+#if defined(LYNIPV_HAS_AVX512F) || defined(LYNIPV_HAS_AVX2)
+# include <immintrin.h>
+#endif
+#ifdef LYNIPV_TELEMETRY
+# include "inplace_vector_telemetry.hpp"
+#endif
 
 namespace lyn {
 
 template<class, std::size_t>
 class inplace_vector;
+template<class>
+class inplace_vector_ref;
+
+#ifdef LYNIPV_NO_EXCEPTIONS
+// Without exceptions, errors that would otherwise throw are reported to a replaceable handler.
+// The handler must not return. If it does, std::abort() is called.
+enum class inplace_vector_error {
+    capacity_exceeded, // would throw std::bad_alloc
+    out_of_range       // would throw std::out_of_range
+};
+using inplace_vector_error_handler = void (*)(inplace_vector_error);
+#endif
 
 namespace lyn_inplace_vector_detail {
+#ifdef LYNIPV_NO_EXCEPTIONS
+# define LYNIPV_TRY if(true)
+# define LYNIPV_CATCH_ALL else
+# define LYNIPV_RETHROW static_cast<void>(0)
+
+    [[noreturn]] inline void default_error_handler(inplace_vector_error) noexcept { std::terminate(); }
+
+    inline std::atomic<inplace_vector_error_handler>& error_handler() noexcept {
+        static std::atomic<inplace_vector_error_handler> handler{&default_error_handler};
+        return handler;
+    }
+
+    [[noreturn]] inline void raise(inplace_vector_error err) noexcept {
+        error_handler().load()(err);
+        std::abort();
+    }
+
+    [[noreturn]] inline void throw_bad_alloc() { raise(inplace_vector_error::capacity_exceeded); }
+    [[noreturn]] inline void throw_out_of_range() { raise(inplace_vector_error::out_of_range); }
+#else
+# define LYNIPV_TRY try
+# define LYNIPV_CATCH_ALL catch(...)
+# define LYNIPV_RETHROW throw
+
+    [[noreturn]] inline void throw_bad_alloc() { throw std::bad_alloc(); }
+    [[noreturn]] inline void throw_out_of_range() { throw std::out_of_range(""); }
+#endif
+
 #if __cplusplus >= 201402L
 # define LYNIPV_CXX14_CONSTEXPR constexpr
 #else
@@ -85,6 +147,9 @@ namespace lyn_inplace_vector_detail {
 #if __cplusplus >= 202002L
 # define LYNIPV_CXX20_CONSTEXPR constexpr
 # define LYNIPV_CONSTRUCT_AT(p, ...) std::construct_at(p __VA_OPT__(, ) __VA_ARGS__)
+# if defined(__cpp_concepts) && __cpp_concepts >= 202002L
+#  define LYNIPV_CONDITIONALLY_TRIVIAL
+# endif
     template<class R, class T>
     concept container_compatiblel_range = std::ranges::input_range<R> && std::convertible_to<std::ranges::range_reference_t<R>, T>;
 #else
@@ -92,6 +157,19 @@ namespace lyn_inplace_vector_detail {
 # define LYNIPV_CONSTRUCT_AT(p, ...) ::new(static_cast<void*>(p)) T(__VA_ARGS__)
 #endif
 
+#ifdef LYNIPV_TELEMETRY
+# if __cplusplus >= 202002L
+#  define LYNIPV_TELEMETRY_HOOK(call)                                                              \
+      do {                                                                                         \
+          if(!std::is_constant_evaluated()) lyn::lyn_inplace_vector_detail::telemetry<T, N>::call; \
+      } while(false)
+# else
+#  define LYNIPV_TELEMETRY_HOOK(call) lyn::lyn_inplace_vector_detail::telemetry<T, N>::call
+# endif
+#else
+# define LYNIPV_TELEMETRY_HOOK(call) static_cast<void>(0)
+#endif
+
 #if defined(LYNIPV_DEBUG) && __cplusplus >= 201703L
     template<class T>
     struct LynIpvDebug {
@@ -113,6 +191,294 @@ namespace lyn_inplace_vector_detail {
 # define TRACE_ENTER(...)
 #endif
 
+    // for the companion headers, which do not see the macros of this header
+    template<class P>
+    constexpr P* launder(P* ptr) noexcept {
+        return LYNIPV_LAUNDER(ptr);
+    }
+
+    // the index of the lowest set bit - precondition: bits != 0
+    inline unsigned countr_zero(unsigned bits) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(bits));
+#else
+        unsigned count = 0;
+        for(; !(bits & 1U); bits >>= 1) ++count;
+        return count;
+#endif
+    }
+    inline unsigned countr_zero(unsigned long long bits) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+        unsigned count = 0;
+        for(; !(bits & 1U); bits >>= 1) ++count;
+        return count;
+#endif
+    }
+
+    // the number of trailing one bits - precondition: bits is not all ones
+    inline unsigned countr_one(unsigned long long bits) noexcept { return countr_zero(~bits); }
+
+    // std::hardware_destructive_interference_size is not reliably available and gcc warns when it is used
+    // in a header, so the common cache line size is assumed.
+    constexpr std::size_t cache_line = 64;
+
+    inline unsigned popcount(unsigned bits) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcount(bits));
+#else
+        unsigned count = 0;
+        for(; bits; bits &= bits - 1) ++count;
+        return count;
+#endif
+    }
+    inline unsigned popcount(unsigned long long bits) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcountll(bits));
+#else
+        unsigned count = 0;
+        for(; bits; bits &= bits - 1) ++count;
+        return count;
+#endif
+    }
+
+    // Bulk relocation of trivially relocatable elements: [first, last) is copied to the uninitialized dst
+    // and [last, end) is moved down to close the gap. The moved-out elements are not destroyed.
+    template<class T>
+    inline void relocate_out(T* dst, T* first, T* last, T* end) noexcept {
+        if(first == last) return;
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), static_cast<std::size_t>(last - first) * sizeof(T));
+        if(last != end) std::memmove(static_cast<void*>(first), static_cast<const void*>(last), static_cast<std::size_t>(end - last) * sizeof(T));
+    }
+
+    // Compaction for erase() and erase_if() on arithmetic types: every element is copied to the output
+    // position, which only advances past the elements that are kept, so there is no branch on the outcome
+    // of the predicate.
+    template<class T, class Pred>
+    LYNIPV_CXX14_CONSTEXPR T* compact_if_branchless(T* first, T* last, T* out, Pred& pred) {
+        for(; first != last; ++first) {
+            const bool drop = static_cast<bool>(pred(*first));
+            *out = *first;
+            out += !drop;
+        }
+        return out;
+    }
+
+    template<class T, class U>
+    struct equal_to_value {
+        const U& value;
+        constexpr bool operator()(const T& elem) const { return elem == value; }
+    };
+
+#if defined(LYNIPV_HAS_AVX512F) || defined(LYNIPV_HAS_AVX2)
+    // 32 and 64 bit elements are compacted a register at a time
+    template<class T>
+    struct simd_compactable :
+        std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && (sizeof(T) == 4 || sizeof(T) == 8)> {};
+    template<std::size_t Size>
+    using element_size = std::integral_constant<std::size_t, Size>;
+#else
+    template<class T>
+    struct simd_compactable : std::false_type {};
+#endif
+
+    // compress_store() stores the elements of the register at `in` that are selected by `keep` packed
+    // together at `out`, which must not be after `in`. The AVX2 version also overwrites the rest of the
+    // register width at `out`. not_equal_mask() selects the elements that do not compare equal to `value`,
+    // which includes NaN.
+#if defined(LYNIPV_HAS_AVX512F)
+    constexpr std::size_t simd_bytes = 64;
+
+    inline void compress_store(void* out, const void* in, unsigned keep, element_size<4>) noexcept {
+        _mm512_mask_compressstoreu_epi32(out, static_cast<__mmask16>(keep), _mm512_loadu_si512(in));
+    }
+    inline void compress_store(void* out, const void* in, unsigned keep, element_size<8>) noexcept {
+        _mm512_mask_compressstoreu_epi64(out, static_cast<__mmask8>(keep), _mm512_loadu_si512(in));
+    }
+
+    template<class T>
+    unsigned not_equal_mask(const T* in, T value, element_size<4>, std::false_type) noexcept {
+        return _mm512_cmpneq_epi32_mask(_mm512_loadu_si512(in), _mm512_set1_epi32(static_cast<int>(value)));
+    }
+    template<class T>
+    unsigned not_equal_mask(const T* in, T value, element_size<8>, std::false_type) noexcept {
+        return _mm512_cmpneq_epi64_mask(_mm512_loadu_si512(in), _mm512_set1_epi64(static_cast<long long>(value)));
+    }
+    inline unsigned not_equal_mask(const float* in, float value, element_size<4>, std::true_type) noexcept {
+        return _mm512_cmp_ps_mask(_mm512_loadu_ps(in), _mm512_set1_ps(value), _CMP_NEQ_UQ);
+    }
+    inline unsigned not_equal_mask(const double* in, double value, element_size<8>, std::true_type) noexcept {
+        return _mm512_cmp_pd_mask(_mm512_loadu_pd(in), _mm512_set1_pd(value), _CMP_NEQ_UQ);
+    }
+#elif defined(LYNIPV_HAS_AVX2)
+    constexpr std::size_t simd_bytes = 32;
+
+    // the 32 bit lanes to keep for every 8 bit mask, packed to the front
+    struct compaction_lanes {
+        compaction_lanes() noexcept {
+            for(unsigned mask = 0; mask != 256; ++mask) {
+                unsigned out = 0;
+                for(unsigned lane = 0; lane != 8; ++lane) {
+                    if(mask >> lane & 1U) lanes[mask][out++] = static_cast<std::uint8_t>(lane);
+                }
+                for(; out != 8; ++out) lanes[mask][out] = 0;
+            }
+        }
+        std::uint8_t lanes[256][8];
+    };
+    inline const compaction_lanes& compaction_table() noexcept {
+        static const compaction_lanes table;
+        return table;
+    }
+
+    inline void compress_store(void* out, const void* in, unsigned keep, element_size<4>) noexcept {
+        const __m128i lanes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(compaction_table().lanes[keep]));
+        const __m256i vec = _mm256_loadu_si256(static_cast<const __m256i*>(in));
+        _mm256_storeu_si256(static_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(vec, _mm256_cvtepu8_epi32(lanes)));
+    }
+    inline void compress_store(void* out, const void* in, unsigned keep, element_size<8>) noexcept {
+        // every 64 bit lane is moved as its two 32 bit halves
+        compress_store(out, in, (keep & 1U) * 3U | (keep & 2U) * 6U | (keep & 4U) * 12U | (keep & 8U) * 24U, element_size<4>{});
+    }
+
+    template<class T>
+    unsigned not_equal_mask(const T* in, T value, element_size<4>, std::false_type) noexcept {
+        const __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)),
+                                              _mm256_set1_epi32(static_cast<int>(value)));
+        return ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq))) & 0xFFU;
+    }
+    template<class T>
+    unsigned not_equal_mask(const T* in, T value, element_size<8>, std::false_type) noexcept {
+        const __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)),
+                                              _mm256_set1_epi64x(static_cast<long long>(value)));
+        return ~static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(eq))) & 0xFU;
+    }
+    inline unsigned not_equal_mask(const float* in, float value, element_size<4>, std::true_type) noexcept {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(in), _mm256_set1_ps(value), _CMP_NEQ_UQ)));
+    }
+    inline unsigned not_equal_mask(const double* in, double value, element_size<8>, std::true_type) noexcept {
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(in), _mm256_set1_pd(value), _CMP_NEQ_UQ)));
+    }
+#endif
+
+#if defined(LYNIPV_HAS_AVX512F) || defined(LYNIPV_HAS_AVX2)
+    // compacts whole registers from `first`, which is left at the unprocessed tail
+    template<class T, class KeepMask>
+    T* compact_blocks(T*& first, T* last, T* out, KeepMask& keep_mask) {
+        constexpr std::size_t lanes = simd_bytes / sizeof(T);
+        for(; static_cast<std::size_t>(last - first) >= lanes; first += lanes) {
+            const unsigned keep = keep_mask(first);
+            compress_store(out, first, keep, element_size<sizeof(T)>{});
+            out += popcount(keep);
+        }
+        return out;
+    }
+
+    template<class T>
+    struct not_equal_keep {
+        T value;
+        unsigned operator()(const T* in) const noexcept {
+            return not_equal_mask(in, value, element_size<sizeof(T)>{}, std::is_floating_point<T>{});
+        }
+    };
+    // The predicate is still called once per element and in order, but its results are stored in an
+    // array that is then loaded as one register. With simple predicates the whole loop vectorizes, and the
+    // stores and the load have the same width so the load can be forwarded from them.
+#if defined(LYNIPV_HAS_AVX512F)
+    template<class T, class Pred>
+    struct predicate_keep {
+        Pred& pred;
+        unsigned operator()(T* in) const {
+            constexpr std::size_t lanes = simd_bytes / sizeof(T);
+            alignas(16) unsigned char drop[lanes];
+            for(std::size_t lane = 0; lane != lanes; ++lane) drop[lane] = static_cast<bool>(pred(in[lane]));
+            const __m128i bytes = _mm_slli_epi16(load(drop, element_size<lanes>{}), 7);
+            return ~static_cast<unsigned>(_mm_movemask_epi8(bytes)) & ((1U << lanes) - 1U);
+        }
+        static __m128i load(const unsigned char* drop, element_size<16>) noexcept {
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(drop));
+        }
+        static __m128i load(const unsigned char* drop, element_size<8>) noexcept {
+            return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(drop));
+        }
+    };
+#else
+    template<class T, class Pred>
+    struct predicate_keep {
+        using lane_type = typename std::conditional<sizeof(T) == 4, std::int32_t, std::int64_t>::type;
+        Pred& pred;
+        unsigned operator()(T* in) const {
+            constexpr std::size_t lanes = simd_bytes / sizeof(T);
+            alignas(32) lane_type drop[lanes];
+            for(std::size_t lane = 0; lane != lanes; ++lane) drop[lane] = -static_cast<lane_type>(static_cast<bool>(pred(in[lane])));
+            const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(drop));
+            return ~movemask(mask, element_size<sizeof(T)>{}) & ((1U << lanes) - 1U);
+        }
+        static unsigned movemask(__m256i mask, element_size<4>) noexcept {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+        }
+        static unsigned movemask(__m256i mask, element_size<8>) noexcept {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+        }
+    };
+#endif
+#endif
+
+    // how erase() and erase_if() remove elements: with the standard algorithms, branchless or with SIMD
+    template<int Kind>
+    using compaction = std::integral_constant<int, Kind>;
+    // erase(c, value) with a value of another type than the elements compares it as it is, not converted
+    template<class T, class U = T>
+    using compaction_for =
+        compaction<simd_compactable<T>::value && std::is_same<T, U>::value ? 2 : std::is_arithmetic<T>::value ? 1 : 0>;
+
+    template<class T, class Pred>
+    LYNIPV_CXX14_CONSTEXPR T* compact_if(T* first, T* last, Pred& pred, compaction<0>) {
+        return std::remove_if(first, last, pred);
+    }
+    template<class T, class Pred>
+    LYNIPV_CXX14_CONSTEXPR T* compact_if(T* first, T* last, Pred& pred, compaction<1>) {
+        return compact_if_branchless(first, last, first, pred);
+    }
+    template<class T, class Pred>
+    LYNIPV_CXX14_CONSTEXPR T* compact_if(T* first, T* last, Pred& pred, compaction<2>) {
+#if __cplusplus >= 202002L
+        if(std::is_constant_evaluated()) return compact_if_branchless(first, last, first, pred);
+#endif
+#if defined(LYNIPV_HAS_AVX512F) || defined(LYNIPV_HAS_AVX2)
+        predicate_keep<T, Pred> keep{pred};
+        T* out = compact_blocks(first, last, first, keep);
+        return compact_if_branchless(first, last, out, pred);
+#else
+        return compact_if_branchless(first, last, first, pred);
+#endif
+    }
+
+    template<class T, class U>
+    LYNIPV_CXX14_CONSTEXPR T* compact_equal(T* first, T* last, const U& value, compaction<0>) {
+        return std::remove(first, last, value);
+    }
+    template<class T, class U>
+    LYNIPV_CXX14_CONSTEXPR T* compact_equal(T* first, T* last, const U& value, compaction<1>) {
+        equal_to_value<T, U> pred{value};
+        return compact_if_branchless(first, last, first, pred);
+    }
+    template<class T>
+    LYNIPV_CXX14_CONSTEXPR T* compact_equal(T* first, T* last, const T& value, compaction<2>) {
+#if __cplusplus >= 202002L
+        if(std::is_constant_evaluated()) return compact_equal(first, last, value, compaction<1>{});
+#endif
+#if defined(LYNIPV_HAS_AVX512F) || defined(LYNIPV_HAS_AVX2)
+        not_equal_keep<T> keep{value};
+        T* out = compact_blocks(first, last, first, keep);
+        equal_to_value<T, T> pred{value};
+        return compact_if_branchless(first, last, out, pred);
+#else
+        return compact_equal(first, last, value, compaction<1>{});
+#endif
+    }
+
     // base requirements
     template<class T, std::size_t N>
     struct constexpr_compat :
@@ -170,9 +536,15 @@ namespace lyn_inplace_vector_detail {
 
         constexpr size_type size() const noexcept { return 0; }
         LYNIPV_CXX14_CONSTEXPR void clear() noexcept {}
+        LYNIPV_CXX14_CONSTEXPR void truncate(size_type) noexcept {}
 
-        LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type inc() { return 0; }
+        LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type inc(size_type = 1) { return 0; }
         LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type dec(size_type = 1) { return 0; }
+        // shared by all empty inplace_vectors and never changed
+        size_type* size_ptr() noexcept {
+            static size_type zero = 0;
+            return &zero;
+        }
     };
 
     template<class T, std::size_t N>
@@ -186,6 +558,14 @@ namespace lyn_inplace_vector_detail {
         using pointer = value_type*;
         using const_pointer = value_type const*;
 
+        // user-provided so that value-initialization does not zero-fill m_data
+        LYNIPV_CXX20_CONSTEXPR aligned_storage_trivial() noexcept {
+#if __cplusplus >= 202002L
+            // but the value of a constexpr variable must not be indeterminate
+            if(std::is_constant_evaluated()) m_data = {};
+#endif
+        }
+
     protected:
         LYNIPV_CXX14_CONSTEXPR pointer ptr(size_type idx) noexcept { return std::addressof(m_data[idx]); }
         LYNIPV_CXX14_CONSTEXPR const_pointer ptr(size_type idx) const noexcept { return std::addressof(m_data[idx]); }
@@ -196,6 +576,7 @@ namespace lyn_inplace_vector_detail {
         LYNIPV_CXX20_CONSTEXPR reference construct_back(Args&&... args) {
             auto& rv = m_data[m_size] = value_type{std::forward<Args>(args)...};
             ++m_size;
+            LYNIPV_TELEMETRY_HOOK(size(m_size));
             return rv;
         }
         LYNIPV_CXX14_CONSTEXPR void destroy(size_type) noexcept {}
@@ -205,9 +586,22 @@ namespace lyn_inplace_vector_detail {
 
         constexpr size_type size() const noexcept { return m_size; }
         LYNIPV_CXX14_CONSTEXPR void clear() noexcept { m_size = 0; }
+        LYNIPV_CXX14_CONSTEXPR void truncate(size_type count) noexcept { m_size = count; }
 
-        LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type inc() noexcept { return ++m_size; }
+        LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type inc(size_type count = 1) noexcept {
+            m_size += count;
+            LYNIPV_TELEMETRY_HOOK(size(m_size));
+            return m_size;
+        }
         LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type dec(size_type count = 1) noexcept { return m_size -= count; }
+        size_type* size_ptr() noexcept { return &m_size; }
+
+#ifdef LYNIPV_TELEMETRY
+    public:
+        LYNIPV_CXX20_CONSTEXPR ~aligned_storage_trivial() { LYNIPV_TELEMETRY_HOOK(destroyed(m_size)); }
+        aligned_storage_trivial(const aligned_storage_trivial&) = default;
+        aligned_storage_trivial& operator=(const aligned_storage_trivial&) = default;
+#endif
 
     private:
         std::array<value_type, N> m_data;
@@ -223,6 +617,8 @@ namespace lyn_inplace_vector_detail {
         using pointer = value_type*;
         using const_pointer = value_type const*;
 
+        aligned_storage_non_trivial() noexcept {}
+
     protected:
         LYNIPV_CXX14_CONSTEXPR pointer ptr(size_type idx) noexcept { return m_data[idx].ptr(); }
         LYNIPV_CXX14_CONSTEXPR const_pointer ptr(size_type idx) const noexcept { return m_data[idx].ptr(); }
@@ -233,6 +629,7 @@ namespace lyn_inplace_vector_detail {
         LYNIPV_CXX20_CONSTEXPR reference construct_back(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value) {
             auto& rv = *LYNIPV_CONSTRUCT_AT(ptr(m_size), std::forward<Args>(args)...);
             ++m_size;
+            LYNIPV_TELEMETRY_HOOK(size(m_size));
             return rv;
         }
         LYNIPV_CXX14_CONSTEXPR void destroy(size_type idx) noexcept { ref(idx).~T(); }
@@ -242,13 +639,35 @@ namespace lyn_inplace_vector_detail {
 
         constexpr size_type size() const noexcept { return m_size; }
 
-        LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type inc() noexcept { return ++m_size; }
+        LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type inc(size_type count = 1) noexcept {
+            m_size += count;
+            LYNIPV_TELEMETRY_HOOK(size(m_size));
+            return m_size;
+        }
         LYNIPV_MAYBE_UNUSED LYNIPV_CXX14_CONSTEXPR size_type dec(size_type count = 1) noexcept { return m_size -= count; }
+        size_type* size_ptr() noexcept { return &m_size; }
         LYNIPV_CXX14_CONSTEXPR void clear() noexcept(std::is_nothrow_destructible<T>::value) {
             while(m_size) {
                 destroy(--m_size);
             }
         }
+        // destroys the elements from count on, back to front, or only stores the size if there is nothing to destroy
+        LYNIPV_CXX14_CONSTEXPR void truncate(size_type count) noexcept {
+            if(!std::is_trivially_destructible<T>::value) {
+                while(m_size != count) destroy(--m_size);
+            }
+            m_size = count;
+        }
+
+#ifdef LYNIPV_TELEMETRY
+    public:
+        // non-trivially destructible T are recorded by the derived destructor before it clears
+        ~aligned_storage_non_trivial() {
+            if(std::is_trivially_destructible<T>::value) LYNIPV_TELEMETRY_HOOK(destroyed(m_size));
+        }
+        aligned_storage_non_trivial(const aligned_storage_non_trivial&) = default;
+        aligned_storage_non_trivial& operator=(const aligned_storage_non_trivial&) = default;
+#endif
 
     private:
         struct alignas(T) inner_storage {
@@ -264,8 +683,104 @@ namespace lyn_inplace_vector_detail {
 
     template<class T, std::size_t N>
     struct storage_selector :
-        std::conditional<constexpr_compat<T, N>::value, aligned_storage_trivial<T, N>, aligned_storage_non_trivial<T, N>>::type {};
+        std::conditional<constexpr_compat<T, N>::value, aligned_storage_trivial<T, N>, aligned_storage_non_trivial<T, N>>::type {
+    protected:
+        using element_type = typename storage_selector::value_type;
 
+        // Makes the elements equal to those of other, moving them out of an rvalue. Assigns the common prefix, constructs
+        // the excess and destroys the surplus, or destroys and reconstructs everything if T is not assignable.
+        LYNIPV_CXX14_CONSTEXPR void assign_from(const storage_selector& other) {
+            assign_elements<const element_type&>(other, std::is_copy_assignable<element_type>{});
+        }
+        LYNIPV_CXX14_CONSTEXPR void assign_from(storage_selector&& other) {
+            assign_elements<element_type&&>(other, std::is_move_assignable<element_type>{});
+        }
+
+    private:
+        template<class Element, class Storage>
+        LYNIPV_CXX14_CONSTEXPR void assign_elements(Storage& other, std::true_type) {
+            auto idx = std::min(this->size(), other.size());
+            while(this->size() > other.size()) {
+                this->destroy(this->dec());
+            }
+            for(decltype(idx) common = 0; common != idx; ++common) {
+                this->ref(common) = static_cast<Element>(other.ref(common));
+            }
+            for(; idx != other.size(); ++idx) {
+                this->construct_back(static_cast<Element>(other.ref(idx)));
+            }
+        }
+        template<class Element, class Storage>
+        LYNIPV_CXX14_CONSTEXPR void assign_elements(Storage& other, std::false_type) {
+            this->clear();
+            for(decltype(this->size()) idx = 0; idx != other.size(); ++idx) {
+                this->construct_back(static_cast<Element>(other.ref(idx)));
+            }
+        }
+    };
+
+#ifdef LYNIPV_CONDITIONALLY_TRIVIAL
+    // C++20: one class with conditionally trivial special member functions replaces the selector chain below
+    template<class T, std::size_t N>
+    struct special_members : storage_selector<T, N> {
+        constexpr special_members() = default;
+
+        constexpr special_members(const special_members&)
+            requires trivial_copy_ctor<T, N>::value
+        = default;
+        constexpr special_members(const special_members& other) {
+            TRACE_ENTER("special_members(const special_members& other)");
+            for(decltype(this->size()) idx = 0; idx != other.size(); ++idx) {
+                this->construct_back(other.ref(idx));
+            }
+        }
+
+        constexpr special_members(special_members&&) noexcept
+            requires trivial_move_ctor<T, N>::value
+        = default;
+        constexpr special_members(special_members&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            TRACE_ENTER("special_members(special_members&& other)");
+            for(decltype(this->size()) idx = 0; idx != other.size(); ++idx) {
+                this->construct_back(std::move(other.ref(idx)));
+            }
+            other.clear();
+        }
+
+        constexpr special_members& operator=(const special_members&)
+            requires trivial_copy_ass<T, N>::value
+        = default;
+        constexpr special_members& operator=(const special_members& other) {
+            TRACE_ENTER("operator=(const special_members& other)");
+            if(this != &other) this->assign_from(other);
+            return *this;
+        }
+
+        constexpr special_members& operator=(special_members&&) noexcept
+            requires trivial_move_ass<T, N>::value
+        = default;
+        constexpr special_members& operator=(special_members&& other) noexcept(
+            std::is_nothrow_move_assignable<T>::value && std::is_nothrow_move_constructible<T>::value) {
+            TRACE_ENTER("operator=(special_members&& other)");
+            if(this != &other) {
+                this->assign_from(std::move(other));
+                other.clear();
+            }
+            return *this;
+        }
+
+        constexpr ~special_members()
+            requires std::is_trivially_destructible<T>::value
+        = default;
+        constexpr ~special_members() noexcept(std::is_nothrow_destructible<T>::value) {
+            TRACE_ENTER("~special_members");
+            LYNIPV_TELEMETRY_HOOK(destroyed(this->size()));
+            this->clear();
+        }
+    };
+
+    template<class T, std::size_t N>
+    struct base_selector : std::conditional<N == 0, aligned_storage_empty<T>, special_members<T, N>>::type {};
+#else
     template<class T, std::size_t N>
     struct non_trivial_destructor : storage_selector<T, N> {
         LYNIPV_CXX14_CONSTEXPR non_trivial_destructor() = default;
@@ -275,6 +790,7 @@ namespace lyn_inplace_vector_detail {
         LYNIPV_CXX14_CONSTEXPR non_trivial_destructor& operator=(non_trivial_destructor&&) noexcept = default;
         LYNIPV_CXX20_CONSTEXPR ~non_trivial_destructor() noexcept(std::is_nothrow_destructible<T>::value) {
             TRACE_ENTER("~non_trival_destructor");
+            LYNIPV_TELEMETRY_HOOK(destroyed(this->size()));
             this->clear();
         }
     };
@@ -289,10 +805,7 @@ namespace lyn_inplace_vector_detail {
         LYNIPV_CXX14_CONSTEXPR non_trivial_copy_ass(non_trivial_copy_ass&&) noexcept = default;
         LYNIPV_CXX14_CONSTEXPR non_trivial_copy_ass& operator=(const non_trivial_copy_ass& other) {
             TRACE_ENTER("operator=(const non_trivial_copy_ass& other)");
-            this->clear(); // may copy assign std::min(size(), other.size()) elements
-            for(decltype(this->size()) idx = 0; idx != other.size(); ++idx) {
-                this->construct_back(other.ref(idx));
-            }
+            if(this != &other) this->assign_from(other);
             return *this;
         }
         LYNIPV_CXX14_CONSTEXPR non_trivial_copy_ass& operator=(non_trivial_copy_ass&&) noexcept = default;
@@ -311,11 +824,10 @@ namespace lyn_inplace_vector_detail {
         LYNIPV_CXX14_CONSTEXPR non_trivial_move_ass& operator=(non_trivial_move_ass&& other) noexcept(
             std::is_nothrow_move_assignable<T>::value && std::is_nothrow_move_constructible<T>::value) {
             TRACE_ENTER("operator=(non_trivial_move_ass&& other)");
-            this->clear(); // may move assign std::min(size(), other.size()) elements
-            for(decltype(this->size()) idx = 0; idx != other.size(); ++idx) {
-                this->construct_back(std::move(other.ref(idx)));
+            if(this != &other) {
+                this->assign_from(std::move(other));
+                other.clear();
             }
-            other.clear();
             return *this;
         }
     };
@@ -363,8 +875,26 @@ namespace lyn_inplace_vector_detail {
 
     template<class T, std::size_t N>
     struct base_selector : std::conditional<N == 0, aligned_storage_empty<T>, move_ctor_selector<T, N>>::type {};
+#endif
 } // namespace lyn_inplace_vector_detail
 
+#ifdef LYNIPV_NO_EXCEPTIONS
+// Installs a new error handler and returns the previous one. A null handler restores the default,
+// which calls std::terminate().
+inline inplace_vector_error_handler set_inplace_vector_error_handler(inplace_vector_error_handler handler) noexcept {
+    return lyn_inplace_vector_detail::error_handler().exchange(handler ? handler
+                                                                       : &lyn_inplace_vector_detail::default_error_handler);
+}
+inline inplace_vector_error_handler get_inplace_vector_error_handler() noexcept {
+    return lyn_inplace_vector_detail::error_handler().load();
+}
+#endif
+
+// Specialize for types that may be moved to a new address with memcpy, forgetting the source without
+// destroying it. splice_back(), split_at() and converting moves between capacities then relocate in bulk.
+template<class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
 template<class T, std::size_t N>
 class inplace_vector : public lyn_inplace_vector_detail::base_selector<T, N> {
     static_assert(std::is_nothrow_destructible<T>::value,
@@ -373,9 +903,17 @@ class inplace_vector : public lyn_inplace_vector_detail::base_selector<T, N> {
     using base::construct_back;
     using base::dec;
     using base::destroy;
+    using base::inc;
     using base::ptr;
     using base::ref;
 
+    template<class, std::size_t>
+    friend class inplace_vector;
+    template<class>
+    friend class inplace_vector_ref;
+    template<class, std::size_t>
+    friend class seqlock_inplace_vector;
+
 public:
     using base::size;
     using base::operator[];
@@ -394,43 +932,178 @@ public:
     using difference_type = typename std::iterator_traits<iterator>::difference_type;
 
 private:
-    LYNIPV_CXX14_CONSTEXPR void shrink_to(const size_type count) noexcept {
-        while(count != size()) {
-            pop_back();
+    LYNIPV_CXX14_CONSTEXPR void shrink_to(const size_type count) noexcept { this->truncate(count); }
+
+    // appends copies of [src, src + count), which must fit - the helpers are templates so that they are
+    // only instantiated when used
+    template<class U>
+    LYNIPV_CXX20_CONSTEXPR void unchecked_copy_back(const U* src, size_type count) {
+        unchecked_copy_back(src, count, std::is_trivially_copyable<U>{});
+    }
+    template<class U>
+    LYNIPV_CXX20_CONSTEXPR void unchecked_copy_back(const U* src, size_type count, std::true_type) {
+#if __cplusplus >= 202002L
+        if(std::is_constant_evaluated()) return unchecked_copy_back(src, count, std::false_type{});
+#endif
+        if(count) std::memcpy(static_cast<void*>(ptr(size())), static_cast<const void*>(src), count * sizeof(T));
+        inc(count);
+    }
+    template<class U>
+    LYNIPV_CXX20_CONSTEXPR void unchecked_copy_back(const U* src, size_type count, std::false_type) {
+        const auto oldsize = size();
+        LYNIPV_TRY {
+            for(; count; --count) unchecked_push_back(*src++);
+        }
+        LYNIPV_CATCH_ALL {
+            shrink_to(oldsize);
+            LYNIPV_RETHROW;
+        }
+    }
+
+    // Appends count elements of a trivially copyable T, which must fit, if write_bytes(dst) copies their object
+    // representations to the uninitialized dst and returns true. Nothing is appended if it returns false.
+    template<class Writer>
+    bool unchecked_append_bytes(size_type count, Writer write_bytes) {
+        static_assert(std::is_trivially_copyable<T>::value, "inplace_vector: T must be trivially copyable");
+        if(!write_bytes(static_cast<void*>(ptr(size())))) return false;
+        inc(count);
+        return true;
+    }
+
+    // replaces the elements with copies of [src, src + count), which must fit, reusing the existing elements
+    template<class U>
+    LYNIPV_CXX20_CONSTEXPR void assign_copies(const U* src, size_type count, std::true_type) {
+        if(size() > count) shrink_to(count);
+        std::copy(src, src + size(), begin());
+        unchecked_copy_back(src + size(), count - size());
+    }
+    template<class U>
+    LYNIPV_CXX20_CONSTEXPR void assign_copies(const U* src, size_type count, std::false_type) {
+        clear();
+        unchecked_copy_back(src, count);
+    }
+
+    // Moves [first, last) of other to the back of *this, which they must fit in, and erases them from other.
+    template<std::size_t M>
+    LYNIPV_CXX20_CONSTEXPR void unchecked_relocate_back(inplace_vector<T, M>& other, T* first, T* last) {
+        unchecked_relocate_back(other, first, last, is_trivially_relocatable<T>{});
+    }
+    template<std::size_t M>
+    LYNIPV_CXX20_CONSTEXPR void unchecked_relocate_back(inplace_vector<T, M>& other, T* first, T* last, std::true_type) {
+#if __cplusplus >= 202002L
+        if(std::is_constant_evaluated()) return unchecked_relocate_back(other, first, last, std::false_type{});
+#endif
+        const auto count = static_cast<size_type>(last - first);
+        if(count == 0) return;
+        lyn_inplace_vector_detail::relocate_out(ptr(size()), first, last, other.end());
+        inc(count);
+        other.dec(count);
+    }
+    template<std::size_t M>
+    LYNIPV_CXX20_CONSTEXPR void unchecked_relocate_back(inplace_vector<T, M>& other, T* first, T* last, std::false_type) {
+        const auto oldsize = size();
+        LYNIPV_TRY {
+            for(auto it = first; it != last; ++it) unchecked_push_back(std::move(*it));
+        }
+        LYNIPV_CATCH_ALL {
+            shrink_to(oldsize);
+            LYNIPV_RETHROW;
+        }
+        other.erase(first, last);
+    }
+
+    // The number of elements from forward iterators is checked once. Ranges of trivially copyable
+    // elements given by pointers are copied in bulk.
+    template<class InputIt>
+    LYNIPV_CXX20_CONSTEXPR void append_iter(InputIt first, InputIt last, std::input_iterator_tag) {
+        std::copy(first, last, std::back_inserter(*this));
+    }
+    template<class ForwardIt>
+    LYNIPV_CXX20_CONSTEXPR void append_iter(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+        const auto count = static_cast<size_type>(std::distance(first, last));
+        if(count > capacity() - size()) lyn_inplace_vector_detail::throw_bad_alloc();
+        append_counted(first, count,
+                       std::integral_constant<bool, std::is_pointer<ForwardIt>::value &&
+                                                        std::is_same<typename std::iterator_traits<ForwardIt>::value_type, T>::value>{});
+    }
+    template<class U>
+    LYNIPV_CXX20_CONSTEXPR void append_counted(const U* first, size_type count, std::true_type) {
+        unchecked_copy_back(first, count);
+    }
+    template<class ForwardIt>
+    LYNIPV_CXX20_CONSTEXPR void append_counted(ForwardIt first, size_type count, std::false_type) {
+        const auto oldsize = size();
+        LYNIPV_TRY {
+            for(; count; --count, ++first) unchecked_emplace_back(*first);
+        }
+        LYNIPV_CATCH_ALL {
+            shrink_to(oldsize);
+            LYNIPV_RETHROW;
         }
     }
 
 public:
     // constructors - copy/move (if any) are defined in the base classes
-    constexpr inplace_vector() noexcept = default;
+    // user-provided, otherwise value-initialization zero-fills the whole storage before running it
+#ifdef LYNIPV_CONDITIONALLY_TRIVIAL
+    constexpr inplace_vector() noexcept
+        requires(N == 0)
+    = default;
+    constexpr inplace_vector() noexcept
+        requires(N != 0)
+    {}
+#else
+    constexpr inplace_vector() noexcept {}
+#endif
 
     template<bool D = std::is_default_constructible<T>::value, typename std::enable_if<D, int>::type = 0>
     LYNIPV_CXX14_CONSTEXPR explicit inplace_vector(size_type count) {
-        if(count > N) throw std::bad_alloc();
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
         while(count != size()) unchecked_emplace_back();
     }
 
     template<bool C = std::is_copy_constructible<T>::value, typename std::enable_if<C, int>::type = 0>
     LYNIPV_CXX14_CONSTEXPR inplace_vector(size_type count, const T& value) {
-        if(count > N) throw std::bad_alloc();
+        if(count > N) lyn_inplace_vector_detail::throw_bad_alloc();
         while(count != size()) unchecked_push_back(value);
     }
 
     template<
         class InputIt, class U = T,
         typename std::enable_if<std::is_constructible<U, typename std::iterator_traits<InputIt>::value_type>::value, int>::type = 0>
-    LYNIPV_CXX14_CONSTEXPR inplace_vector(InputIt first, InputIt last) {
-        std::copy(first, last, std::back_inserter(*this));
+    LYNIPV_CXX20_CONSTEXPR inplace_vector(InputIt first, InputIt last) {
+        append_iter(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
     }
 
     template<bool C = std::is_copy_constructible<T>::value, typename std::enable_if<C, int>::type = 0>
     constexpr inplace_vector(std::initializer_list<T> init) : inplace_vector(init.begin(), init.end()) {}
 
+    // Conversions from other capacities are implicit when every element is guaranteed to fit and explicit,
+    // throwing std::bad_alloc if the elements do not fit, otherwise. The source of a converting move is left empty.
+    template<std::size_t M, typename std::enable_if<(M < N) && std::is_copy_constructible<T>::value, int>::type = 0>
+    LYNIPV_CXX20_CONSTEXPR inplace_vector(const inplace_vector<T, M>& other) {
+        unchecked_copy_back(other.data(), other.size());
+    }
+    template<std::size_t M, typename std::enable_if<(M > N) && std::is_copy_constructible<T>::value, int>::type = 0>
+    LYNIPV_CXX20_CONSTEXPR explicit inplace_vector(const inplace_vector<T, M>& other) {
+        if(other.size() > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        unchecked_copy_back(other.data(), other.size());
+    }
+    template<std::size_t M, typename std::enable_if<(M < N) && std::is_move_constructible<T>::value, int>::type = 0>
+    LYNIPV_CXX20_CONSTEXPR inplace_vector(inplace_vector<T, M>&& other) {
+        unchecked_relocate_back(other, other.begin(), other.end());
+    }
+    template<std::size_t M, typename std::enable_if<(M > N) && std::is_move_constructible<T>::value, int>::type = 0>
+    LYNIPV_CXX20_CONSTEXPR explicit inplace_vector(inplace_vector<T, M>&& other) {
+        if(other.size() > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        unchecked_relocate_back(other, other.begin(), other.end());
+    }
+
 #if __cplusplus >= 202302L && defined(__cpp_lib_containers_ranges)
     template<lyn_inplace_vector_detail::container_compatiblel_range<T> R>
     constexpr inplace_vector(std::from_range_t, R&& rg) {
         if constexpr(std::ranges::sized_range<R>) {
-            if(std::ranges::size(rg) > N) throw std::bad_alloc();
+            if(std::ranges::size(rg) > N) lyn_inplace_vector_detail::throw_bad_alloc();
             for(auto&& val : rg) unchecked_emplace_back(std::forward<decltype(val)>(val));
         } else {
             for(auto&& val : rg) emplace_back(std::forward<decltype(val)>(val));
@@ -442,15 +1115,31 @@ public:
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto operator=(std::initializer_list<T> init) ->
         typename std::enable_if<std::is_copy_constructible<U>::value, inplace_vector&>::type {
-        if(init.size() > capacity()) throw std::bad_alloc();
+        if(init.size() > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         assign(init.begin(), init.end());
         return *this;
     }
 
+    // assignment from other capacities, throwing std::bad_alloc if the elements do not fit
+    template<std::size_t M, typename std::enable_if<M != N && std::is_copy_constructible<T>::value, int>::type = 0>
+    LYNIPV_CXX20_CONSTEXPR inplace_vector& operator=(const inplace_vector<T, M>& other) {
+        if(other.size() > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        assign_copies(other.data(), other.size(),
+                      std::integral_constant<bool, std::is_copy_assignable<T>::value && !std::is_trivially_copyable<T>::value>{});
+        return *this;
+    }
+    template<std::size_t M, typename std::enable_if<M != N && std::is_move_constructible<T>::value, int>::type = 0>
+    LYNIPV_CXX20_CONSTEXPR inplace_vector& operator=(inplace_vector<T, M>&& other) {
+        if(other.size() > N) lyn_inplace_vector_detail::throw_bad_alloc();
+        clear();
+        unchecked_relocate_back(other, other.begin(), other.end());
+        return *this;
+    }
+
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto assign(size_type count, const T& value) ->
         typename std::enable_if<std::is_copy_constructible<U>::value>::type {
-        if(count > capacity()) throw std::bad_alloc();
+        if(count > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         clear();
         while(count != size()) push_back(value);
     }
@@ -460,13 +1149,13 @@ public:
         typename std::enable_if<std::is_constructible<U, typename std::iterator_traits<InputIt>::value_type>::value>::type {
         TRACE_ENTER("assign(InputIt first, InputIt last) ", std::distance(first, last));
         clear();
-        std::copy(first, last, std::back_inserter(*this));
+        append_iter(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
     }
 
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto assign(std::initializer_list<T> ilist) ->
         typename std::enable_if<std::is_copy_constructible<U>::value>::type {
-        if(ilist.size() > capacity()) throw std::bad_alloc();
+        if(ilist.size() > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         clear();
         std::copy(ilist.begin(), ilist.end(), std::back_inserter(*this));
     }
@@ -485,7 +1174,7 @@ public:
         requires std::constructible_from<T&, std::ranges::range_reference_t<R>>
     {
         if constexpr(std::ranges::sized_range<R>) {
-            if(size() + std::ranges::size(rg) > capacity()) throw std::bad_alloc();
+            if(size() + std::ranges::size(rg) > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
             for(auto&& val : rg) {
                 unchecked_emplace_back(std::forward<decltype(val)>(val));
             }
@@ -502,7 +1191,10 @@ public:
     {
         auto it = std::ranges::begin(rg);
         for(auto end = std::ranges::end(rg); it != end; std::ranges::advance(it, 1)) {
-            if(size() == capacity()) break;
+            if(size() == capacity()) {
+                LYNIPV_TELEMETRY_HOOK(try_failed());
+                break;
+            }
             unchecked_emplace_back(*it);
         }
         return it;
@@ -511,11 +1203,11 @@ public:
 
     // element access
     LYNIPV_CXX14_CONSTEXPR reference at(size_type idx) {
-        if(idx >= size()) throw std::out_of_range("");
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
         return ref(idx);
     }
     LYNIPV_CXX14_CONSTEXPR const_reference at(size_type idx) const {
-        if(idx >= size()) throw std::out_of_range("");
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
         return ref(idx);
     }
     LYNIPV_CXX14_CONSTEXPR reference front() noexcept { return ref(0); }
@@ -574,19 +1266,19 @@ private:
 public:
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto resize(size_type count) -> typename std::enable_if<std::is_default_constructible<U>::value>::type {
-        if(count > capacity()) throw std::bad_alloc();
+        if(count > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         unchecked_resize(count);
     }
 
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto resize(size_type count, const value_type& value) ->
         typename std::enable_if<std::is_copy_constructible<U>::value>::type {
-        if(count > capacity()) throw std::bad_alloc();
+        if(count > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         unchecked_resize(count, value);
     }
 
     static LYNIPV_CXX14_CONSTEXPR void reserve(size_type new_cap) {
-        if(new_cap > capacity()) throw std::bad_alloc();
+        if(new_cap > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
     }
     static LYNIPV_CXX14_CONSTEXPR void shrink_to_fit() noexcept {}
 
@@ -612,7 +1304,7 @@ public:
     LYNIPV_CXX14_CONSTEXPR auto insert(const_iterator pos, const T& value) ->
         typename std::enable_if<std::is_copy_constructible<U>::value, iterator>::type {
         // static_assert(std::is_nothrow_move_assignable<T>::value, "only nothrow move assignable types may be used for now");
-        if(size() == capacity()) throw std::bad_alloc();
+        if(size() == capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         const auto ncpos = const_cast<iterator>(pos);
         unchecked_push_back(value);
         std::rotate(ncpos, std::prev(end()), end());
@@ -623,7 +1315,7 @@ public:
     LYNIPV_CXX14_CONSTEXPR auto insert(const_iterator pos, T&& value) ->
         typename std::enable_if<std::is_move_constructible<U>::value, iterator>::type {
         // static_assert(std::is_nothrow_move_assignable<T>::value, "only nothrow move assignable types may be used for now");
-        if(size() == capacity()) throw std::bad_alloc();
+        if(size() == capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         const auto ncpos = const_cast<iterator>(pos);
         unchecked_push_back(std::move(value));
         std::rotate(ncpos, std::prev(end()), end());
@@ -634,17 +1326,18 @@ public:
     LYNIPV_CXX20_CONSTEXPR auto insert(const_iterator pos, size_type count, const T& value) ->
         typename std::enable_if<std::is_copy_constructible<U>::value, iterator>::type {
         // static_assert(std::is_nothrow_move_assignable<T>::value, "only nothrow move assignable types may be used for now");
-        if(size() + count > capacity()) throw std::bad_alloc();
+        if(size() + count > capacity()) lyn_inplace_vector_detail::throw_bad_alloc();
         const auto ncpos = const_cast<iterator>(pos);
         auto oldsize = size();
         auto first_inserted = end();
-        try {
+        LYNIPV_TRY {
             while(count--) {
                 unchecked_push_back(value);
             }
-        } catch(...) {
+        }
+        LYNIPV_CATCH_ALL {
             shrink_to(oldsize);
-            throw;
+            LYNIPV_RETHROW;
         }
         std::rotate(ncpos, first_inserted, end());
         return ncpos;
@@ -658,13 +1351,14 @@ public:
         const auto ncpos = const_cast<iterator>(pos);
         auto oldsize = size();
         auto first_inserted = end();
-        try {
+        LYNIPV_TRY {
             for(; first != last; std::advance(first, 1)) {
                 push_back(*first);
             }
-        } catch(...) {
+        }
+        LYNIPV_CATCH_ALL {
             shrink_to(oldsize);
-            throw;
+            LYNIPV_RETHROW;
         }
         std::rotate(ncpos, first_inserted, end());
         return ncpos;
@@ -706,47 +1400,126 @@ public:
     template<class... Args>
     LYNIPV_CXX14_CONSTEXPR auto emplace_back(Args&&... args) ->
         typename std::enable_if<std::is_constructible<T, Args...>::value, reference>::type {
-        if(size() == N) throw std::bad_alloc();
+        if(size() == N) lyn_inplace_vector_detail::throw_bad_alloc();
         return unchecked_emplace_back(std::forward<Args>(args)...);
     }
 
     template<class... Args>
     LYNIPV_CXX14_CONSTEXPR auto try_emplace_back(Args&&... args) ->
         typename std::enable_if<std::is_constructible<T, Args...>::value, pointer>::type {
-        if(size() == N) return nullptr;
+        if(size() == N) {
+            LYNIPV_TELEMETRY_HOOK(try_failed());
+            return nullptr;
+        }
         return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
     }
 
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto push_back(T const& value) ->
         typename std::enable_if<std::is_copy_constructible<U>::value, reference>::type {
-        if(size() == N) throw std::bad_alloc();
+        if(size() == N) lyn_inplace_vector_detail::throw_bad_alloc();
         return unchecked_push_back(value);
     }
 
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto push_back(T&& value) ->
         typename std::enable_if<std::is_move_constructible<U>::value, reference>::type {
-        if(size() == N) throw std::bad_alloc();
+        if(size() == N) lyn_inplace_vector_detail::throw_bad_alloc();
         return unchecked_push_back(std::move(value));
     }
 
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto try_push_back(T const& value) ->
         typename std::enable_if<std::is_copy_constructible<U>::value, pointer>::type {
-        if(size() == N) return nullptr;
+        if(size() == N) {
+            LYNIPV_TELEMETRY_HOOK(try_failed());
+            return nullptr;
+        }
         return std::addressof(unchecked_push_back(value));
     }
 
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto try_push_back(T&& value) ->
         typename std::enable_if<std::is_move_constructible<U>::value, pointer>::type {
-        if(size() == N) return nullptr;
+        if(size() == N) {
+            LYNIPV_TELEMETRY_HOOK(try_failed());
+            return nullptr;
+        }
         return std::addressof(unchecked_push_back(std::move(value)));
     }
 
     LYNIPV_CXX14_CONSTEXPR void pop_back() noexcept { destroy(dec()); }
 
+    // checkpoints, for undoing speculative push_backs when backtracking
+    //
+    // A marker is the size of the vector when checkpoint() was called. It goes stale when the vector shrinks
+    // below it, for example by rolling back to an earlier checkpoint, and unless NDEBUG is defined, rollback()
+    // asserts that the marker is not above the size. A marker that is stale because the vector has grown back
+    // past it again can not be detected. With LYNIPV_DEBUG, markers also record the vector they were taken from
+    // and rollback() asserts that it is this one, which is kept opt-in since it changes the size of a marker.
+    class marker {
+    public:
+        constexpr size_type size() const noexcept { return m_size; }
+
+    private:
+        friend class inplace_vector;
+#ifdef LYNIPV_DEBUG
+        constexpr marker(size_type size, const inplace_vector* owner) noexcept : m_size(size), m_owner(owner) {}
+
+        size_type m_size;
+        const inplace_vector* m_owner;
+#else
+        constexpr explicit marker(size_type size) noexcept : m_size(size) {}
+
+        size_type m_size;
+#endif
+    };
+
+    // Rolls the vector back to the checkpoint taken when it was created, unless commit() is called first.
+    // Guards nest, and an inner guard must be destroyed or committed before an outer guard rolls back.
+    class checkpoint_guard {
+    public:
+        explicit LYNIPV_CXX14_CONSTEXPR checkpoint_guard(inplace_vector& vec) noexcept : m_vec(&vec), m_mark(vec.checkpoint()) {}
+        LYNIPV_CXX14_CONSTEXPR checkpoint_guard(checkpoint_guard&& other) noexcept : m_vec(other.m_vec), m_mark(other.m_mark) {
+            other.m_vec = nullptr;
+        }
+        checkpoint_guard(const checkpoint_guard&) = delete;
+        checkpoint_guard& operator=(const checkpoint_guard&) = delete;
+        checkpoint_guard& operator=(checkpoint_guard&&) = delete;
+        LYNIPV_CXX20_CONSTEXPR ~checkpoint_guard() {
+            if(m_vec) m_vec->rollback(m_mark);
+        }
+
+        // keeps the elements added since the checkpoint
+        LYNIPV_CXX14_CONSTEXPR void commit() noexcept { m_vec = nullptr; }
+        // rolls back now and stays active, so the guard can be reused for the next trial - after commit() or
+        // after the guard has been moved from, it does nothing
+        LYNIPV_CXX14_CONSTEXPR void rollback() noexcept {
+            if(m_vec) m_vec->rollback(m_mark);
+        }
+        constexpr marker checkpoint() const noexcept { return m_mark; }
+
+    private:
+        inplace_vector* m_vec;
+        marker m_mark;
+    };
+
+#ifdef LYNIPV_DEBUG
+    constexpr marker checkpoint() const noexcept { return marker(size(), this); }
+#else
+    constexpr marker checkpoint() const noexcept { return marker(size()); }
+#endif
+    // destroys the elements added since the checkpoint in one pass, or only stores the size if T is trivially
+    // destructible
+    LYNIPV_CXX14_CONSTEXPR void rollback(marker mark) noexcept {
+#ifdef LYNIPV_DEBUG
+        assert(mark.m_owner == this && "inplace_vector: rollback to a checkpoint of another vector");
+#endif
+        assert(mark.m_size <= size() && "inplace_vector: rollback to a stale checkpoint");
+        if(mark.m_size < size()) shrink_to(mark.m_size);
+    }
+    LYNIPV_CXX14_CONSTEXPR checkpoint_guard scoped_checkpoint() noexcept { return checkpoint_guard(*this); }
+
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto erase(const_iterator first, const_iterator last) ->
         typename std::enable_if<!std::is_const<U>::value, iterator>::type {
@@ -766,6 +1539,28 @@ public:
         return erase(pos, std::next(pos));
     }
 
+    // Moves [first, last) of other, which must not be *this, to the back and erases them from other.
+    // Returns an iterator to the first moved element. Throws std::bad_alloc, changing nothing, if they do not fit.
+    template<std::size_t M, class U = T>
+    LYNIPV_CXX20_CONSTEXPR auto splice_back(inplace_vector<T, M>& other, typename inplace_vector<T, M>::const_iterator first,
+                                            typename inplace_vector<T, M>::const_iterator last) ->
+        typename std::enable_if<std::is_move_constructible<U>::value && !std::is_const<U>::value, iterator>::type {
+        assert(static_cast<const void*>(&other) != this);
+        if(static_cast<size_type>(last - first) > capacity() - size()) lyn_inplace_vector_detail::throw_bad_alloc();
+        const auto oldsize = size();
+        unchecked_relocate_back(other, const_cast<T*>(first), const_cast<T*>(last));
+        return std::next(begin(), static_cast<difference_type>(oldsize));
+    }
+
+    // Moves [pos, end()) into the returned inplace_vector.
+    template<class U = T>
+    LYNIPV_CXX20_CONSTEXPR auto split_at(const_iterator pos) ->
+        typename std::enable_if<std::is_move_constructible<U>::value && !std::is_const<U>::value, inplace_vector>::type {
+        inplace_vector rv;
+        rv.unchecked_relocate_back(*this, const_cast<iterator>(pos), end());
+        return rv;
+    }
+
     template<class U = T>
     LYNIPV_CXX14_CONSTEXPR auto swap(inplace_vector& other) noexcept(N == 0 ||
                                                                      (lyn_inplace_vector_detail::is_nothrow_swappable<T>::value &&
@@ -810,17 +1605,18 @@ public:
     }
 };
 
+// arithmetic types are compacted without branching on the predicate, a register at a time with AVX2 or AVX-512
 template<class T, size_t N, class U = T>
 LYNIPV_CXX14_CONSTEXPR typename inplace_vector<T, N>::size_type erase(inplace_vector<T, N>& c, const U& value) {
-    auto it = std::remove(c.begin(), c.end(), value);
+    auto it = lyn_inplace_vector_detail::compact_equal(c.begin(), c.end(), value, lyn_inplace_vector_detail::compaction_for<T, U>{});
     auto r = static_cast<typename inplace_vector<T, N>::size_type>(std::distance(it, c.end()));
-    c.erase(it, it.end());
+    c.erase(it, c.end());
     return r;
 }
 
 template<class T, size_t N, class Predicate>
 LYNIPV_CXX14_CONSTEXPR typename inplace_vector<T, N>::size_type erase_if(inplace_vector<T, N>& c, Predicate pred) {
-    auto it = std::remove_if(c.begin(), c.end(), pred);
+    auto it = lyn_inplace_vector_detail::compact_if(c.begin(), c.end(), pred, lyn_inplace_vector_detail::compaction_for<T>{});
     auto r = static_cast<typename inplace_vector<T, N>::size_type>(std::distance(it, c.end()));
     c.erase(it, c.end());
     return r;
@@ -834,5 +1630,12 @@ LYNIPV_CXX14_CONSTEXPR typename inplace_vector<T, N>::size_type erase_if(inplace
 #undef LYNIPV_CONSTRUCT_AT
 #undef LYNIPV_LAUNDER
 #undef LYNIPV_MAYBE_UNUSED
+#undef LYNIPV_CONDITIONALLY_TRIVIAL
+#undef LYNIPV_TELEMETRY_HOOK
+#undef LYNIPV_HAS_AVX512F
+#undef LYNIPV_HAS_AVX2
+#undef LYNIPV_TRY
+#undef LYNIPV_CATCH_ALL
+#undef LYNIPV_RETHROW
 
 #endif
@@ -0,0 +1,236 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_6C0E3FAA_CB5F_11F1_B884_02FC00000001
+#define LYNIPV_6C0E3FAA_CB5F_11F1_B884_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+template<class T>
+class span_vector;
+
+// A non-owning reference to an inplace_vector<T, N> of any capacity. It holds pointers to the elements and
+// the size of the referenced inplace_vector, and its capacity, so functions taking an inplace_vector_ref<T>
+// are compiled once per T instead of once per (T, N). Copies refer to the same inplace_vector, which must
+// outlive them. A span_vector<T> converts to an inplace_vector_ref<T> too. Changes made through the
+// reference are not recorded by the capacity telemetry.
+template<class T>
+class inplace_vector_ref {
+    static_assert(!std::is_const<T>::value, "inplace_vector_ref: T must not be const");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using iterator = T*;
+    using const_iterator = T const*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type = std::ptrdiff_t;
+
+    template<std::size_t N>
+    inplace_vector_ref(inplace_vector<T, N>& vec) noexcept : // NOLINT(google-explicit-constructor)
+        m_data(vec.data()), m_size(vec.size_ptr()), m_capacity(N) {}
+
+    // element access
+    reference at(size_type idx) {
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
+        return m_data[idx];
+    }
+    const_reference at(size_type idx) const {
+        if(idx >= size()) lyn_inplace_vector_detail::throw_out_of_range();
+        return m_data[idx];
+    }
+    reference operator[](size_type idx) noexcept { return m_data[idx]; }
+    const_reference operator[](size_type idx) const noexcept { return m_data[idx]; }
+    reference front() noexcept { return m_data[0]; }
+    const_reference front() const noexcept { return m_data[0]; }
+    reference back() noexcept { return m_data[size() - 1]; }
+    const_reference back() const noexcept { return m_data[size() - 1]; }
+    pointer data() noexcept { return m_data; }
+    const_pointer data() const noexcept { return m_data; }
+
+    // iterators
+    iterator begin() noexcept { return m_data; }
+    iterator end() noexcept { return m_data + size(); }
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator end() const noexcept { return m_data + size(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // size and capacity
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept { return *m_size; }
+    size_type max_size() const noexcept { return m_capacity; }
+    size_type capacity() const noexcept { return m_capacity; }
+
+    // modifiers
+    template<class... Args>
+    reference unchecked_emplace_back(Args&&... args) {
+        auto& rv = *::new(static_cast<void*>(m_data + size())) T(std::forward<Args>(args)...);
+        ++*m_size;
+        return rv;
+    }
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        if(size() == m_capacity) lyn_inplace_vector_detail::throw_bad_alloc();
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    pointer try_emplace_back(Args&&... args) {
+        if(size() == m_capacity) return nullptr;
+        return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+    }
+    reference push_back(const T& value) { return emplace_back(value); }
+    reference push_back(T&& value) { return emplace_back(std::move(value)); }
+    pointer try_push_back(const T& value) { return try_emplace_back(value); }
+    pointer try_push_back(T&& value) { return try_emplace_back(std::move(value)); }
+    void pop_back() noexcept { (m_data + --*m_size)->~T(); }
+
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const auto ncpos = const_cast<iterator>(pos);
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(ncpos, std::prev(end()), end());
+        return ncpos;
+    }
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        if(count > m_capacity - size()) lyn_inplace_vector_detail::throw_bad_alloc();
+        const auto ncpos = const_cast<iterator>(pos);
+        const auto first_inserted = end();
+        rollback guard(*this);
+        while(count--) unchecked_emplace_back(value);
+        guard.dismiss();
+        std::rotate(ncpos, first_inserted, end());
+        return ncpos;
+    }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        const auto ncpos = const_cast<iterator>(pos);
+        const auto first_inserted = end();
+        rollback guard(*this);
+        for(; first != last; ++first) emplace_back(*first);
+        guard.dismiss();
+        std::rotate(ncpos, first_inserted, end());
+        return ncpos;
+    }
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto ncfirst = const_cast<iterator>(first);
+        if(first == last) return ncfirst;
+        shrink_to(static_cast<size_type>(std::move(const_cast<iterator>(last), end(), ncfirst) - m_data));
+        return ncfirst;
+    }
+    void clear() noexcept { shrink_to(0); }
+
+    void assign(size_type count, const T& value) {
+        if(count > m_capacity) lyn_inplace_vector_detail::throw_bad_alloc();
+        clear();
+        resize(count, value);
+    }
+    // Throws std::bad_alloc if the elements do not fit, keeping those that did.
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        for(; first != last; ++first) emplace_back(*first);
+    }
+    void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    void resize(size_type count) {
+        if(count > m_capacity) lyn_inplace_vector_detail::throw_bad_alloc();
+        if(count < size()) return shrink_to(count);
+        rollback guard(*this);
+        while(count != size()) unchecked_emplace_back();
+        guard.dismiss();
+    }
+    void resize(size_type count, const T& value) {
+        if(count > m_capacity) lyn_inplace_vector_detail::throw_bad_alloc();
+        if(count < size()) return shrink_to(count);
+        rollback guard(*this);
+        while(count != size()) unchecked_emplace_back(value);
+        guard.dismiss();
+    }
+
+private:
+    friend class span_vector<T>;
+    inplace_vector_ref(pointer data, size_type* size, size_type capacity) noexcept : m_data(data), m_size(size), m_capacity(capacity) {}
+
+    // destroys the elements appended since construction unless dismissed
+    class rollback {
+    public:
+        explicit rollback(inplace_vector_ref& ref) noexcept : m_ref(&ref), m_size(ref.size()) {}
+        rollback(const rollback&) = delete;
+        rollback& operator=(const rollback&) = delete;
+        ~rollback() {
+            if(m_ref) m_ref->shrink_to(m_size);
+        }
+        void dismiss() noexcept { m_ref = nullptr; }
+
+    private:
+        inplace_vector_ref* m_ref;
+        size_type m_size;
+    };
+
+    // only writes the size if it changes, the size of every inplace_vector<T, 0> is shared
+    void shrink_to(size_type count) noexcept {
+        while(size() != count) pop_back();
+    }
+
+    pointer m_data;
+    size_type* m_size;
+    size_type m_capacity;
+};
+
+} // namespace lyn
+
+#endif
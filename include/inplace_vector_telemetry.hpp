@@ -0,0 +1,152 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_3CED47CC_CB58_11F1_BE5B_02FC00000001
+#define LYNIPV_3CED47CC_CB58_11F1_BE5B_02FC00000001
+
+// Capacity telemetry for inplace_vector. Included by inplace_vector.hpp when LYNIPV_TELEMETRY is defined.
+//
+// For every inplace_vector<T, N> instantiation in use, a record keeps
+// - the maximum size() reached,
+// - a histogram of size() at destruction, in nine buckets: bucket k < 8 counts sizes in [k*N/8, (k+1)*N/8)
+//   and bucket 8 counts full vectors. Moved-from vectors count as destroyed at the size they were left with.
+// - the number of try_* member functions that failed because the vector was full.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <ostream>
+#include <string>
+
+namespace lyn {
+
+struct inplace_vector_telemetry_record {
+    static constexpr std::size_t buckets = 9;
+
+    const char* signature; // the signature of a function in the instantiation, with T and N spelled out
+    std::size_t capacity;
+    std::atomic<std::size_t> max_size;
+    std::atomic<std::size_t> try_failures;
+    std::atomic<std::size_t> destroyed[buckets];
+    inplace_vector_telemetry_record* next;
+
+    // "T = ...; N = ..." or similar, depending on the compiler
+    std::string instantiation() const {
+        std::string sig(signature);
+        auto beg = sig.find('[');
+        auto end = sig.rfind(']');
+        if(beg == std::string::npos || end == std::string::npos || end < beg) return sig;
+        sig = sig.substr(beg + 1, end - beg - 1);
+        return sig.compare(0, 5, "with ") == 0 ? sig.substr(5) : sig;
+    }
+};
+
+class inplace_vector_telemetry {
+public:
+    template<class F>
+    static void for_each(F&& func) {
+        for(auto rec = head().load(std::memory_order_acquire); rec; rec = rec->next) func(*rec);
+    }
+
+    static void dump(std::ostream& os) {
+        os << "inplace_vector telemetry: max_size, try_failures, sizes at destruction in eighths of capacity (last is full)\n";
+        for_each([&os](const inplace_vector_telemetry_record& rec) {
+            os << rec.instantiation() << "\n  max_size=" << rec.max_size.load(std::memory_order_relaxed) << '/' << rec.capacity
+               << " try_failures=" << rec.try_failures.load(std::memory_order_relaxed) << " destroyed=[";
+            for(std::size_t idx = 0; idx != inplace_vector_telemetry_record::buckets; ++idx) {
+                os << (idx ? " " : "") << rec.destroyed[idx].load(std::memory_order_relaxed);
+            }
+            os << "]\n";
+        });
+    }
+
+    // dumps to std::cerr when the program exits normally - registers only once
+    static void dump_at_exit() {
+        static const bool registered = std::atexit([] { dump(std::cerr); }) == 0;
+        static_cast<void>(registered);
+    }
+
+    static void reset() noexcept {
+        for_each([](inplace_vector_telemetry_record& rec) {
+            rec.max_size.store(0, std::memory_order_relaxed);
+            rec.try_failures.store(0, std::memory_order_relaxed);
+            for(auto& bucket : rec.destroyed) bucket.store(0, std::memory_order_relaxed);
+        });
+    }
+
+    static void link(inplace_vector_telemetry_record& rec) noexcept {
+        rec.next = head().load(std::memory_order_relaxed);
+        while(!head().compare_exchange_weak(rec.next, &rec, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+private:
+    static std::atomic<inplace_vector_telemetry_record*>& head() noexcept {
+        static std::atomic<inplace_vector_telemetry_record*> first{nullptr};
+        return first;
+    }
+};
+
+namespace lyn_inplace_vector_detail {
+    template<class T, std::size_t N>
+    struct telemetry {
+        static const char* signature() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return __FUNCSIG__;
+#else
+            return __PRETTY_FUNCTION__;
+#endif
+        }
+
+        static inplace_vector_telemetry_record& record() noexcept {
+            static inplace_vector_telemetry_record rec{signature(), N, {}, {}, {}, nullptr};
+            static const bool linked = (inplace_vector_telemetry::link(rec), true);
+            static_cast<void>(linked);
+            return rec;
+        }
+
+        static void size(std::size_t count) noexcept {
+            auto& max = record().max_size;
+            auto cur = max.load(std::memory_order_relaxed);
+            while(count > cur && !max.compare_exchange_weak(cur, count, std::memory_order_relaxed)) {
+            }
+        }
+
+        static void destroyed(std::size_t count) noexcept {
+            record().destroyed[count * 8 / N].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void try_failed() noexcept { record().try_failures.fetch_add(1, std::memory_order_relaxed); }
+    };
+} // namespace lyn_inplace_vector_detail
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,130 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_C31A7344_CB5B_11F1_9B88_02FC00000001
+#define LYNIPV_C31A7344_CB5B_11F1_9B88_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lyn {
+
+// A bounded Chase-Lev work stealing deque with N slots in the object itself. One owner thread pushes and
+// pops at the bottom while any number of thieves steal from the top.
+//
+// The owner's push is a relaxed slot store and a release store of the bottom index. pop only needs a
+// compare-and-swap when it races the thieves for the last element. Thieves claim an element with a
+// compare-and-swap on the top index. Sequentially consistent operations are used where the algorithm has
+// fences, which thread sanitizers understand.
+//
+// Elements are held in std::atomic<T> so T must be trivially copyable and is typically a task pointer or
+// a small task descriptor. The indices are kept on separate cache lines from each other and the slots.
+template<class T, std::size_t N>
+class inplace_work_stealing_deque {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "inplace_work_stealing_deque: N must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "inplace_work_stealing_deque: T must be trivially copyable");
+
+    using index_type = std::int64_t;
+    static constexpr index_type mask = static_cast<index_type>(N - 1);
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    inplace_work_stealing_deque() = default;
+    inplace_work_stealing_deque(const inplace_work_stealing_deque&) = delete;
+    inplace_work_stealing_deque& operator=(const inplace_work_stealing_deque&) = delete;
+
+    // owner only - try_push returns false and push throws std::bad_alloc when full
+    bool try_push(const T& value) noexcept {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed);
+        const auto top = m_top.load(std::memory_order_acquire);
+        if(bottom - top >= static_cast<index_type>(N)) return false;
+        m_slots[bottom & mask].store(value, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+    void push(const T& value) {
+        if(!try_push(value)) lyn_inplace_vector_detail::throw_bad_alloc();
+    }
+
+    // owner only - takes the most recently pushed element, returns false if there was none left
+    bool pop(T& out) noexcept {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        auto top = m_top.load(std::memory_order_seq_cst);
+        if(top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = m_slots[bottom & mask].load(std::memory_order_relaxed);
+        if(top != bottom) return true;
+        // the last element, which a thief may be taking too
+        const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // any thread - takes the least recently pushed element, returns false if there was none or if another
+    // thread took it first
+    bool steal(T& out) noexcept {
+        auto top = m_top.load(std::memory_order_seq_cst);
+        const auto bottom = m_bottom.load(std::memory_order_seq_cst);
+        if(top >= bottom) return false;
+        const T value = m_slots[top & mask].load(std::memory_order_relaxed);
+        if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return false;
+        out = value;
+        return true;
+    }
+
+    // snapshots that may be stale by the time they are used unless called by the owner with no thieves
+    size_type size() const noexcept {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed);
+        const auto top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+private:
+    alignas(lyn_inplace_vector_detail::cache_line) std::atomic<index_type> m_top{0};
+    alignas(lyn_inplace_vector_detail::cache_line) std::atomic<index_type> m_bottom{0};
+    alignas(lyn_inplace_vector_detail::cache_line) std::atomic<T> m_slots[N];
+};
+
+template<class T, std::size_t N>
+constexpr typename inplace_work_stealing_deque<T, N>::index_type inplace_work_stealing_deque<T, N>::mask;
+
+} // namespace lyn
+
+#endif
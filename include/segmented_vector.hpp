@@ -0,0 +1,293 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_57B29564_CB60_11F1_A68B_02FC00000001
+#define LYNIPV_57B29564_CB60_11F1_A68B_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lyn {
+
+namespace lyn_segmented_vector_detail {
+    constexpr std::size_t log2(std::size_t val) noexcept { return val < 2 ? 0 : 1 + log2(val / 2); }
+} // namespace lyn_segmented_vector_detail
+
+// A growable sequence stored in heap allocated inplace_vector<T, ChunkN> chunks, which are owned by a
+// directory of pointers. Growing only ever adds chunks, so elements are never moved or copied and
+// pointers, references and iterators stay valid until the element is popped. Only the directory is
+// reallocated, which moves one pointer per chunk. Indexing is a shift and a mask when ChunkN is a power
+// of two. Chunks emptied by pop_back() and clear() are kept for reuse until shrink_to_fit().
+template<class T, std::size_t ChunkN>
+class segmented_vector {
+    static_assert(ChunkN != 0, "segmented_vector: ChunkN must be greater than zero");
+    static_assert(!std::is_const<T>::value, "segmented_vector: T must not be const");
+
+    using chunk_type = inplace_vector<T, ChunkN>;
+    using chunk_ptr = std::unique_ptr<chunk_type>;
+
+    static constexpr bool pow2 = (ChunkN & (ChunkN - 1)) == 0;
+    static constexpr std::size_t shift = lyn_segmented_vector_detail::log2(ChunkN);
+
+    static constexpr std::size_t chunk_of(std::size_t idx) noexcept { return pow2 ? idx >> shift : idx / ChunkN; }
+    static constexpr std::size_t offset_of(std::size_t idx) noexcept { return pow2 ? idx & (ChunkN - 1) : idx % ChunkN; }
+
+    template<bool Const>
+    class basic_iterator {
+        using vector_ptr = typename std::conditional<Const, const segmented_vector*, segmented_vector*>::type;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T*, T*>::type;
+        using reference = typename std::conditional<Const, const T&, T&>::type;
+
+        basic_iterator() = default;
+        template<bool C = Const, typename std::enable_if<C, int>::type = 0>
+        basic_iterator(const basic_iterator<false>& other) noexcept : m_vec(other.m_vec), m_idx(other.m_idx) {}
+
+        reference operator*() const noexcept { return (*m_vec)[m_idx]; }
+        pointer operator->() const noexcept { return std::addressof((*m_vec)[m_idx]); }
+        reference operator[](difference_type off) const noexcept { return (*m_vec)[m_idx + static_cast<std::size_t>(off)]; }
+
+        basic_iterator& operator++() noexcept {
+            ++m_idx;
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto rv = *this;
+            ++m_idx;
+            return rv;
+        }
+        basic_iterator& operator--() noexcept {
+            --m_idx;
+            return *this;
+        }
+        basic_iterator operator--(int) noexcept {
+            auto rv = *this;
+            --m_idx;
+            return rv;
+        }
+        basic_iterator& operator+=(difference_type off) noexcept {
+            m_idx += static_cast<std::size_t>(off);
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type off) noexcept {
+            m_idx -= static_cast<std::size_t>(off);
+            return *this;
+        }
+        friend basic_iterator operator+(basic_iterator it, difference_type off) noexcept { return it += off; }
+        friend basic_iterator operator+(difference_type off, basic_iterator it) noexcept { return it += off; }
+        friend basic_iterator operator-(basic_iterator it, difference_type off) noexcept { return it -= off; }
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.m_idx - rhs.m_idx);
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx == rhs.m_idx; }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx != rhs.m_idx; }
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx < rhs.m_idx; }
+        friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx > rhs.m_idx; }
+        friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx <= rhs.m_idx; }
+        friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept { return lhs.m_idx >= rhs.m_idx; }
+
+    private:
+        friend class segmented_vector;
+        template<bool>
+        friend class basic_iterator;
+        basic_iterator(vector_ptr vec, std::size_t idx) noexcept : m_vec(vec), m_idx(idx) {}
+
+        vector_ptr m_vec = nullptr;
+        std::size_t m_idx = 0;
+    };
+
+    // the contiguous elements of one chunk
+    template<class U>
+    class basic_segment {
+    public:
+        basic_segment(U* first, std::size_t count) noexcept : m_data(first), m_size(count) {}
+
+        U* begin() const noexcept { return m_data; }
+        U* end() const noexcept { return m_data + m_size; }
+        U* data() const noexcept { return m_data; }
+        std::size_t size() const noexcept { return m_size; }
+        bool empty() const noexcept { return m_size == 0; }
+        U& operator[](std::size_t idx) const noexcept { return m_data[idx]; }
+
+    private:
+        U* m_data;
+        std::size_t m_size;
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using segment = basic_segment<T>;
+    using const_segment = basic_segment<const T>;
+
+    static constexpr size_type chunk_capacity() noexcept { return ChunkN; }
+
+    segmented_vector() = default;
+    segmented_vector(const segmented_vector& other) : m_size(other.m_size) {
+        m_chunks.reserve(other.chunk_count());
+        for(size_type idx = 0; idx != other.chunk_count(); ++idx) {
+            m_chunks.push_back(chunk_ptr(new chunk_type(*other.m_chunks[idx])));
+        }
+    }
+    segmented_vector(segmented_vector&& other) noexcept :
+        m_chunks(std::move(other.m_chunks)), m_size(other.m_size) {
+        other.m_size = 0;
+    }
+    segmented_vector(std::initializer_list<T> ilist) {
+        for(auto& value : ilist) push_back(value);
+    }
+    segmented_vector& operator=(const segmented_vector& other) {
+        if(this != &other) segmented_vector(other).swap(*this);
+        return *this;
+    }
+    segmented_vector& operator=(segmented_vector&& other) noexcept {
+        segmented_vector(std::move(other)).swap(*this);
+        return *this;
+    }
+    ~segmented_vector() = default;
+
+    // element access
+    reference operator[](size_type idx) noexcept { return (*m_chunks[chunk_of(idx)])[offset_of(idx)]; }
+    const_reference operator[](size_type idx) const noexcept { return (*m_chunks[chunk_of(idx)])[offset_of(idx)]; }
+    reference at(size_type idx) {
+        if(idx >= m_size) lyn_inplace_vector_detail::throw_out_of_range();
+        return (*this)[idx];
+    }
+    const_reference at(size_type idx) const {
+        if(idx >= m_size) lyn_inplace_vector_detail::throw_out_of_range();
+        return (*this)[idx];
+    }
+    reference front() noexcept { return m_chunks.front()->front(); }
+    const_reference front() const noexcept { return m_chunks.front()->front(); }
+    reference back() noexcept { return (*this)[m_size - 1]; }
+    const_reference back() const noexcept { return (*this)[m_size - 1]; }
+
+    // the elements as contiguous segments, one per chunk, for loops that should vectorize
+    size_type chunk_count() const noexcept { return chunk_of(m_size + ChunkN - 1); }
+    segment chunk(size_type idx) noexcept { return segment(m_chunks[idx]->data(), m_chunks[idx]->size()); }
+    const_segment chunk(size_type idx) const noexcept { return const_segment(m_chunks[idx]->data(), m_chunks[idx]->size()); }
+
+    // iterators
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, m_size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // size and capacity
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return static_cast<size_type>(std::numeric_limits<difference_type>::max()); }
+    size_type capacity() const noexcept { return m_chunks.size() * ChunkN; }
+
+    // allocates the chunks needed for `count` elements up front
+    void reserve(size_type count) {
+        const auto chunks = chunk_of(count + ChunkN - 1);
+        if(chunks <= m_chunks.size()) return;
+        m_chunks.reserve(chunks);
+        while(m_chunks.size() != chunks) m_chunks.push_back(chunk_ptr(new chunk_type));
+    }
+    // frees the chunks that hold no elements
+    void shrink_to_fit() {
+        m_chunks.resize(chunk_count());
+        m_chunks.shrink_to_fit();
+    }
+
+    // modifiers
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        const auto idx = chunk_of(m_size);
+        if(idx == m_chunks.size()) m_chunks.push_back(chunk_ptr(new chunk_type));
+        auto& rv = m_chunks[idx]->unchecked_emplace_back(std::forward<Args>(args)...);
+        ++m_size;
+        return rv;
+    }
+    reference push_back(const T& value) { return emplace_back(value); }
+    reference push_back(T&& value) { return emplace_back(std::move(value)); }
+    void pop_back() noexcept {
+        --m_size;
+        m_chunks[chunk_of(m_size)]->pop_back();
+    }
+    void clear() noexcept {
+        for(size_type idx = 0; idx != chunk_count(); ++idx) m_chunks[idx]->clear();
+        m_size = 0;
+    }
+
+    void swap(segmented_vector& other) noexcept {
+        m_chunks.swap(other.m_chunks);
+        std::swap(m_size, other.m_size);
+    }
+    friend void swap(segmented_vector& lhs, segmented_vector& rhs) noexcept { lhs.swap(rhs); }
+
+    friend bool operator==(const segmented_vector& lhs, const segmented_vector& rhs) {
+        if(lhs.size() != rhs.size()) return false;
+        for(size_type idx = 0; idx != lhs.chunk_count(); ++idx) {
+            if(*lhs.m_chunks[idx] != *rhs.m_chunks[idx]) return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const segmented_vector& lhs, const segmented_vector& rhs) { return !(lhs == rhs); }
+
+private:
+    std::vector<chunk_ptr> m_chunks;
+    size_type m_size = 0;
+};
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,150 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_3712D6AE_CB63_11F1_8575_02FC00000001
+#define LYNIPV_3712D6AE_CB63_11F1_8575_02FC00000001
+
+#include "inplace_vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace lyn {
+
+// An inplace_vector<T, N> published by one writer to any number of readers through a sequence lock.
+// Readers copy the elements out with snapshot() and retry when the writer was active meanwhile. They never
+// write to the shared object, so reads do not bounce cache lines between the readers.
+//
+// The elements are held as machine words in std::atomic so that the racing copies are well defined and
+// understood by thread sanitizers. The writer makes the sequence counter odd and then stores the words
+// with release, and the readers load them with acquire. A reader that sees any word of an update therefore
+// also sees the counter change. On x86 these are plain loads and stores.
+//
+// Only one thread may write at a time. Concurrent writers must be serialized by the caller.
+template<class T, std::size_t N>
+class seqlock_inplace_vector {
+    static_assert(std::is_trivially_copyable<T>::value, "seqlock_inplace_vector: T must be trivially copyable");
+    static_assert(N != 0, "seqlock_inplace_vector: N must be greater than zero");
+
+    using word = std::size_t;
+    static constexpr std::size_t words = (sizeof(T) * N + sizeof(word) - 1) / sizeof(word);
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using snapshot_type = inplace_vector<T, N>;
+
+    seqlock_inplace_vector() noexcept {
+        for(auto& wrd : m_words) wrd.store(0, std::memory_order_relaxed);
+    }
+    explicit seqlock_inplace_vector(const snapshot_type& init) noexcept : seqlock_inplace_vector() { store(init); }
+    seqlock_inplace_vector(const seqlock_inplace_vector&) = delete;
+    seqlock_inplace_vector& operator=(const seqlock_inplace_vector&) = delete;
+
+    static constexpr size_type capacity() noexcept { return N; }
+    // the size of the last update that was started, it may be in progress
+    size_type size() const noexcept { return m_size.load(std::memory_order_acquire); }
+
+    // readers
+
+    // a consistent copy of the elements, retrying until no update overlaps the copy
+    snapshot_type snapshot() const noexcept {
+        snapshot_type out;
+        while(!try_snapshot(out)) {
+        }
+        return out;
+    }
+    // Copies the elements into `out` and returns true, or returns false, leaving `out` empty, if an update
+    // overlapped the copy. The words are copied straight into the uninitialized storage of `out`.
+    bool try_snapshot(snapshot_type& out) const noexcept {
+        out.clear();
+        const auto seq = m_seq.load(std::memory_order_acquire);
+        if(seq & 1U) return false;
+        const auto count = m_size.load(std::memory_order_acquire);
+        return out.unchecked_append_bytes(count, [&](void* dst) {
+            const auto bytes = static_cast<unsigned char*>(dst);
+            const auto byte_count = count * sizeof(T);
+            const auto whole = byte_count / sizeof(word);
+            for(std::size_t idx = 0; idx != whole; ++idx) {
+                const word wrd = m_words[idx].load(std::memory_order_acquire);
+                std::memcpy(bytes + idx * sizeof(word), &wrd, sizeof(word));
+            }
+            // the last word may extend past the storage of out
+            if(const auto tail = byte_count % sizeof(word)) {
+                const word wrd = m_words[whole].load(std::memory_order_acquire);
+                std::memcpy(bytes + whole * sizeof(word), &wrd, tail);
+            }
+            return m_seq.load(std::memory_order_relaxed) == seq;
+        });
+    }
+
+    // the writer
+
+    void store(const snapshot_type& value) noexcept {
+        const auto seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        m_size.store(value.size(), std::memory_order_release);
+        const auto bytes = reinterpret_cast<const unsigned char*>(value.data());
+        const auto byte_count = value.size() * sizeof(T);
+        for(std::size_t idx = 0; idx != words_for(value.size()); ++idx) {
+            word wrd = 0;
+            const auto offset = idx * sizeof(word);
+            std::memcpy(&wrd, bytes + offset, byte_count - offset < sizeof(word) ? byte_count - offset : sizeof(word));
+            m_words[idx].store(wrd, std::memory_order_release);
+        }
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+    // calls `func` with a copy of the elements and publishes the copy afterwards
+    template<class Func>
+    void update(Func&& func) {
+        snapshot_type copy = load_unsynchronized();
+        func(copy);
+        store(copy);
+    }
+
+private:
+    static constexpr std::size_t words_for(std::size_t count) noexcept { return (sizeof(T) * count + sizeof(word) - 1) / sizeof(word); }
+
+    // only the writer may read without the sequence check
+    snapshot_type load_unsynchronized() const noexcept {
+        snapshot_type out;
+        try_snapshot(out);
+        return out;
+    }
+
+    alignas(lyn_inplace_vector_detail::cache_line) std::atomic<unsigned> m_seq{0};
+    std::atomic<size_type> m_size{0};
+    std::atomic<word> m_words[words];
+};
+
+} // namespace lyn
+
+#endif
@@ -0,0 +1,249 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+// Original: https://github.com/TedLyngmo/inplace_vector
+
+// NOLINTNEXTLINE(llvm-header-guard)
+#ifndef LYNIPV_00B82916_CB67_11F1_9269_02FC00000001
+#define LYNIPV_00B82916_CB67_11F1_9269_02FC00000001
+
+#include "inplace_vector.hpp"
+#include "inplace_vector_ref.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace lyn {
+
+// A vector over a buffer owned by someone else, like a region of an arena, a shared memory segment or a
+// stack array sized at run time, with a capacity given at construction. It owns the elements, which it
+// destroys, but not the buffer, which it never allocates, frees or grows. Running out of capacity is
+// reported like in inplace_vector: push_back() and friends throw std::bad_alloc, or call the error handler
+// without exceptions, and the try_ functions return nullptr.
+//
+// The sequence operations are those of inplace_vector_ref, which a span_vector converts to, so functions
+// taking an inplace_vector_ref<T> work on both. Moving a span_vector hands over the buffer, leaving the
+// source without one, while copy assignment copies the elements into the buffer of the target.
+template<class T>
+class span_vector {
+    static_assert(!std::is_const<T>::value, "span_vector: T must not be const");
+    static_assert(std::is_nothrow_destructible<T>::value, "span_vector: classes with potentially throwing destructors are prohibited");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using iterator = T*;
+    using const_iterator = T const*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type = std::ptrdiff_t;
+
+    // constructors
+    span_vector() = default;
+    // Precondition: storage is suitably aligned for T, has room for capacity elements and outlives *this.
+    span_vector(void* storage, size_type capacity) noexcept : m_data(static_cast<pointer>(storage)), m_capacity(capacity) {}
+    span_vector(void* storage, size_type capacity, std::initializer_list<T> ilist) : span_vector(storage, capacity) {
+        assign(ilist);
+    }
+    span_vector(const span_vector&) = delete;
+    span_vector(span_vector&& other) noexcept : m_data(other.m_data), m_size(other.m_size), m_capacity(other.m_capacity) {
+        other.release();
+    }
+    ~span_vector() { clear(); }
+
+    // assignment
+    span_vector& operator=(const span_vector& other) {
+        if(this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    span_vector& operator=(span_vector&& other) noexcept {
+        if(this != &other) {
+            clear();
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            other.release();
+        }
+        return *this;
+    }
+    span_vector& operator=(std::initializer_list<T> ilist) {
+        assign(ilist);
+        return *this;
+    }
+
+    operator inplace_vector_ref<T>() noexcept { return ref(); } // NOLINT(google-explicit-constructor)
+
+    // element access
+    reference at(size_type idx) { return ref().at(idx); }
+    const_reference at(size_type idx) const {
+        if(idx >= m_size) lyn_inplace_vector_detail::throw_out_of_range();
+        return m_data[idx];
+    }
+    reference operator[](size_type idx) noexcept { return m_data[idx]; }
+    const_reference operator[](size_type idx) const noexcept { return m_data[idx]; }
+    reference front() noexcept { return m_data[0]; }
+    const_reference front() const noexcept { return m_data[0]; }
+    reference back() noexcept { return m_data[m_size - 1]; }
+    const_reference back() const noexcept { return m_data[m_size - 1]; }
+    pointer data() noexcept { return m_data; }
+    const_pointer data() const noexcept { return m_data; }
+
+    // iterators
+    iterator begin() noexcept { return m_data; }
+    iterator end() noexcept { return m_data + m_size; }
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // size and capacity
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return m_capacity; }
+    size_type capacity() const noexcept { return m_capacity; }
+    void reserve(size_type new_cap) const {
+        if(new_cap > m_capacity) lyn_inplace_vector_detail::throw_bad_alloc();
+    }
+    void shrink_to_fit() const noexcept {}
+    void resize(size_type count) { ref().resize(count); }
+    void resize(size_type count, const T& value) { ref().resize(count, value); }
+
+    // modifiers
+    template<class... Args>
+    reference unchecked_emplace_back(Args&&... args) {
+        return ref().unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        return ref().emplace_back(std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    pointer try_emplace_back(Args&&... args) {
+        return ref().try_emplace_back(std::forward<Args>(args)...);
+    }
+    reference unchecked_push_back(const T& value) { return ref().unchecked_emplace_back(value); }
+    reference unchecked_push_back(T&& value) { return ref().unchecked_emplace_back(std::move(value)); }
+    reference push_back(const T& value) { return ref().push_back(value); }
+    reference push_back(T&& value) { return ref().push_back(std::move(value)); }
+    pointer try_push_back(const T& value) { return ref().try_push_back(value); }
+    pointer try_push_back(T&& value) { return ref().try_push_back(std::move(value)); }
+    void pop_back() noexcept { ref().pop_back(); }
+
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        return ref().emplace(pos, std::forward<Args>(args)...);
+    }
+    iterator insert(const_iterator pos, const T& value) { return ref().insert(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return ref().insert(pos, std::move(value)); }
+    iterator insert(const_iterator pos, size_type count, const T& value) { return ref().insert(pos, count, value); }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        return ref().insert(pos, first, last);
+    }
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist) { return ref().insert(pos, ilist); }
+
+    iterator erase(const_iterator pos) { return ref().erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return ref().erase(first, last); }
+    void clear() noexcept { ref().clear(); }
+
+    void assign(size_type count, const T& value) { ref().assign(count, value); }
+    template<class InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void assign(InputIt first, InputIt last) {
+        ref().assign(first, last);
+    }
+    void assign(std::initializer_list<T> ilist) { ref().assign(ilist); }
+
+    // Moves [first, last) of other, which must not be *this, to the back and erases them from other, in
+    // bulk for trivially relocatable T like inplace_vector::splice_back(). Returns an iterator to the first
+    // moved element. Throws std::bad_alloc, changing nothing, if they do not fit.
+    iterator splice_back(span_vector& other, const_iterator first, const_iterator last) {
+        assert(&other != this);
+        const auto count = static_cast<size_type>(last - first);
+        if(count > m_capacity - m_size) lyn_inplace_vector_detail::throw_bad_alloc();
+        const auto oldsize = m_size;
+        relocate_back(other, const_cast<iterator>(first), const_cast<iterator>(last), is_trivially_relocatable<T>{});
+        return begin() + static_cast<difference_type>(oldsize);
+    }
+
+    // swaps the buffers, so no element is moved
+    void swap(span_vector& other) noexcept {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+    friend void swap(span_vector& lhs, span_vector& rhs) noexcept { lhs.swap(rhs); }
+
+    friend bool operator==(const span_vector& lhs, const span_vector& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator!=(const span_vector& lhs, const span_vector& rhs) { return !(lhs == rhs); }
+    friend bool operator<(const span_vector& lhs, const span_vector& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    inplace_vector_ref<T> ref() noexcept { return inplace_vector_ref<T>(m_data, &m_size, m_capacity); }
+
+    void release() noexcept {
+        m_data = nullptr;
+        m_size = 0;
+        m_capacity = 0;
+    }
+
+    void relocate_back(span_vector& other, iterator first, iterator last, std::true_type) noexcept {
+        lyn_inplace_vector_detail::relocate_out(end(), first, last, other.end());
+        const auto count = static_cast<size_type>(last - first);
+        m_size += count;
+        other.m_size -= count;
+    }
+    void relocate_back(span_vector& other, iterator first, iterator last, std::false_type) {
+        ref().insert(end(), std::make_move_iterator(first), std::make_move_iterator(last));
+        other.erase(first, last);
+    }
+
+    pointer m_data = nullptr;
+    size_type m_size = 0;
+    size_type m_capacity = 0;
+};
+
+} // namespace lyn
+
+#endif
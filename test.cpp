@@ -1,8 +1,16 @@
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #if __cplusplus >= 201703L
@@ -10,9 +18,45 @@
 #endif
 
 #include "inplace_vector.hpp"
+#include "inplace_vector_ref.hpp"
+#include "span_vector.hpp"
+#include "segmented_vector.hpp"
+#include "inplace_eytzinger.hpp"
+#include "inplace_channel.hpp"
+#include "inplace_devector.hpp"
+#include "inplace_list.hpp"
+#include "inplace_memory_resource.hpp"
+#include "inplace_packed_vector.hpp"
+#include "inplace_lru_cache.hpp"
+#include "inplace_set_algorithm.hpp"
+#include "inplace_slot_map.hpp"
+#include "inplace_string.hpp"
+#include "inplace_top_k.hpp"
+#include "inplace_unordered_map.hpp"
 
 using namespace lyn;
 
+// counting allocations to verify that elements are reused where possible
+namespace {
+std::size_t allocations = 0;
+
+template<class T>
+struct counting_allocator {
+    using value_type = T;
+    counting_allocator() = default;
+    template<class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+    T* allocate(std::size_t count) {
+        ++allocations;
+        return std::allocator<T>{}.allocate(count);
+    }
+    void deallocate(T* ptr, std::size_t count) noexcept { std::allocator<T>{}.deallocate(ptr, count); }
+    friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept { return true; }
+    friend bool operator!=(const counting_allocator&, const counting_allocator&) noexcept { return false; }
+};
+using counted_string = std::basic_string<char, std::char_traits<char>, counting_allocator<char>>;
+} // namespace
+
 // empty:
 template class lyn::inplace_vector<int, 0>;
 
@@ -232,6 +276,577 @@ struct trivially_move_constructible {
     ~trivially_move_constructible() = default;
 };
 
+// puts every key in the same home bucket to exercise probing and backward shift deletion
+struct colliding_hash {
+    std::size_t operator()(int) const noexcept { return 0; }
+};
+
+// random operations checked against std::unordered_map
+template<class Map>
+void unordered_map_random_ops(Map& map) {
+    std::unordered_map<int, int> ref;
+    unsigned state = 1;
+    for(int op = 0; op != 20000; ++op) {
+        state = state * 1103515245U + 12345U;
+        int key = static_cast<int>((state >> 16) % 40);
+        if((state >> 8) & 1) {
+            auto erased = map.erase(key);
+            auto ref_erased = ref.erase(key);
+            ASSERT_EQ(erased, ref_erased);
+        } else if(ref.size() < map.capacity() || ref.count(key)) {
+            map[key] = op;
+            ref[key] = op;
+        }
+        ASSERT_EQ(map.size(), ref.size());
+    }
+    for(auto& kv : ref) ASSERT_EQ(map.at(kv.first), kv.second);
+    std::size_t visited = 0;
+    for(auto& kv : map) {
+        ASSERT_EQ(ref.at(kv.first), kv.second);
+        ++visited;
+    }
+    ASSERT_EQ(visited, ref.size());
+}
+
+// random operations checked against a std::vector, with every query checked after every operation
+template<std::size_t Bits>
+void packed_vector_random_ops() {
+    using packed = inplace_packed_vector<Bits, 150>;
+    using value_type = typename packed::value_type;
+    packed vec;
+    std::vector<value_type> ref;
+    const unsigned values = Bits == 1 ? 2U : Bits < 4 ? 1U << Bits : 16U;
+    unsigned state = 1;
+    for(int op = 0; op != 3000; ++op) {
+        state = state * 1103515245U + 12345U;
+        const auto value = static_cast<value_type>((state >> 16) % values << (Bits > 4 ? Bits - 4 : 0));
+        const auto pos = ref.empty() ? 0 : static_cast<std::size_t>(state >> 20) % ref.size();
+        switch((state >> 8) % 6) {
+        case 0:
+        case 1:
+            if(vec.full()) break;
+            vec.push_back(value);
+            ref.push_back(value);
+            break;
+        case 2:
+            if(vec.full()) break;
+            vec.insert(vec.begin() + static_cast<std::ptrdiff_t>(pos), value);
+            ref.insert(ref.begin() + static_cast<std::ptrdiff_t>(pos), value);
+            break;
+        case 3:
+            if(ref.empty()) break;
+            vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(pos));
+            ref.erase(ref.begin() + static_cast<std::ptrdiff_t>(pos));
+            break;
+        case 4: {
+            const auto last = std::min(ref.size(), pos + (state >> 4) % 70);
+            vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(pos), vec.begin() + static_cast<std::ptrdiff_t>(last));
+            ref.erase(ref.begin() + static_cast<std::ptrdiff_t>(pos), ref.begin() + static_cast<std::ptrdiff_t>(last));
+            break;
+        }
+        default: {
+            const auto count = static_cast<std::size_t>(state >> 12) % (vec.capacity() + 1);
+            vec.resize(count, value);
+            ref.resize(count, value);
+        }
+        }
+        ASSERT_EQ(vec.size(), ref.size());
+        assert(std::equal(ref.begin(), ref.end(), vec.begin()));
+        const auto nonzero = static_cast<std::size_t>(std::count_if(ref.begin(), ref.end(), [](value_type elem) { return elem != 0; }));
+        ASSERT_EQ(vec.count(), nonzero);
+        const auto equal = static_cast<std::size_t>(std::count(ref.begin(), ref.end(), value));
+        ASSERT_EQ(vec.count(value), equal);
+        const auto first_equal = static_cast<std::size_t>(std::find(ref.begin(), ref.end(), value) - ref.begin());
+        const auto found_equal = vec.find_first(value);
+        ASSERT_EQ(found_equal, first_equal == ref.size() ? packed::npos : first_equal);
+        std::size_t visited = 0;
+        for(auto idx = vec.find_first(); idx != packed::npos; idx = vec.find_next(idx + 1)) {
+            assert(ref[idx] != 0);
+            ++visited;
+        }
+        ASSERT_EQ(visited, nonzero);
+        assert(vec == packed(ref.begin(), ref.end())); // also checks that the bits after the end are zero
+    }
+}
+
+// random operations checked against a std::list in recency order
+template<class Cache>
+void lru_cache_random_ops(Cache& cache) {
+    std::list<std::pair<int, int>> ref; // most recently used first
+    auto ref_find = [&](int key) {
+        return std::find_if(ref.begin(), ref.end(), [key](const std::pair<int, int>& kv) { return kv.first == key; });
+    };
+    unsigned state = 1;
+    for(int op = 0; op != 20000; ++op) {
+        state = state * 1103515245U + 12345U;
+        const int key = static_cast<int>((state >> 16) % 60);
+        const auto it = ref_find(key);
+        switch((state >> 8) & 3) {
+        case 0: {
+            const int* value = cache.get(key);
+            assert((value == nullptr) == (it == ref.end()));
+            if(value) {
+                ASSERT_EQ(*value, it->second);
+                ref.splice(ref.begin(), ref, it);
+            }
+            break;
+        }
+        case 1: {
+            const bool erased = cache.erase(key);
+            ASSERT_EQ(erased, it != ref.end());
+            if(it != ref.end()) ref.erase(it);
+            break;
+        }
+        case 2: {
+            const int value = cache.get_or_emplace(key, [op] { return op; });
+            if(it != ref.end()) {
+                ASSERT_EQ(value, it->second);
+                ref.splice(ref.begin(), ref, it);
+            } else {
+                ASSERT_EQ(value, op);
+                if(ref.size() == cache.capacity()) ref.pop_back();
+                ref.emplace_front(key, op);
+            }
+            break;
+        }
+        default:
+            cache.put(key, op);
+            if(it != ref.end()) ref.erase(it);
+            if(ref.size() == cache.capacity()) ref.pop_back();
+            ref.emplace_front(key, op);
+        }
+        ASSERT_EQ(cache.size(), ref.size());
+    }
+    assert(std::equal(ref.begin(), ref.end(), cache.begin(), [](const std::pair<int, int>& lhs, const std::pair<const int, int>& rhs) {
+        return lhs.first == rhs.first && lhs.second == rhs.second;
+    }));
+}
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+// a single threaded executor running fire and forget coroutines, which are started in spawn order and
+// then resumed by the channels they wait on
+struct executor {
+    struct task {
+        struct promise_type {
+            task get_return_object() noexcept { return {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    void spawn(task tsk) { tasks.push_back(tsk.handle); }
+    void run() {
+        for(auto handle : tasks) handle.resume();
+    }
+    bool done() const {
+        return std::all_of(tasks.begin(), tasks.end(), [](std::coroutine_handle<> handle) { return handle.done(); });
+    }
+    ~executor() {
+        for(auto handle : tasks) handle.destroy();
+    }
+
+    std::vector<std::coroutine_handle<>> tasks;
+};
+
+executor::task produce(inplace_channel<std::string, 2>& ch, int count) {
+    for(int idx = 0; idx != count; ++idx) {
+        bool sent = co_await ch.send(std::to_string(idx));
+        assert(sent);
+    }
+    ch.close();
+}
+
+executor::task consume(inplace_channel<std::string, 2>& ch, std::vector<std::string>& out) {
+    while(auto value = co_await ch.receive()) out.push_back(std::move(*value));
+}
+
+executor::task send_all(inplace_channel<int, 1>& ch, int count, int& sent) {
+    for(int idx = 0; idx != count; ++idx) {
+        if(!co_await ch.send(idx)) co_return;
+        ++sent;
+    }
+}
+#endif
+
+// sorted random values, strictly increasing unless duplicates are allowed
+template<class T, std::size_t N>
+inplace_vector<T, N> sorted_values(std::size_t count, unsigned& state, unsigned range, bool duplicates = false) {
+    inplace_vector<T, N> rv;
+    while(rv.size() != count) {
+        state = state * 1103515245U + 12345U;
+        rv.push_back(static_cast<T>(static_cast<long long>((state >> 8) % range) - static_cast<long long>(range / 4)));
+    }
+    std::sort(rv.begin(), rv.end());
+    if(!duplicates) rv.erase(std::unique(rv.begin(), rv.end()), rv.end());
+    return rv;
+}
+
+// the set algorithms checked against the std algorithms, for sizes that take the galloping, block and
+// scalar paths
+template<class T>
+void set_algorithms() {
+    unsigned state = 7;
+    const std::size_t sizes[][2] = {{0, 0}, {0, 50}, {3, 200}, {200, 3}, {7, 9}, {100, 100}, {400, 300}, {10, 400}};
+    for(auto& sz : sizes) {
+        for(unsigned range : {100U, 1000U, 100000U}) {
+            auto a = sorted_values<T, 400>(sz[0], state, range);
+            auto b = sorted_values<T, 400>(sz[1], state, range);
+            std::vector<T> expected;
+            inplace_vector<T, 800> out;
+
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            set_intersection(a, b, out);
+            assert(expected.size() == out.size() && std::equal(expected.begin(), expected.end(), out.begin()));
+            ASSERT_EQ(intersection_size(a, b), expected.size());
+
+            expected.clear();
+            out.clear();
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            set_union(a, b, out);
+            assert(expected.size() == out.size() && std::equal(expected.begin(), expected.end(), out.begin()));
+
+            expected.clear();
+            out.clear();
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            set_difference(a, b, out);
+            assert(expected.size() == out.size() && std::equal(expected.begin(), expected.end(), out.begin()));
+
+            a = sorted_values<T, 400>(sz[0], state, range, true);
+            b = sorted_values<T, 400>(sz[1], state, range, true);
+            expected.clear();
+            out.clear();
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            merge(a, b, out);
+            assert(expected.size() == out.size() && std::equal(expected.begin(), expected.end(), out.begin()));
+        }
+    }
+}
+
+// owns memory, so a double destruction after relocation would be caught by the sanitizers
+struct relocatable {
+    std::unique_ptr<int> value;
+    explicit relocatable(int val) : value(new int(val)) {}
+};
+namespace lyn {
+template<>
+struct is_trivially_relocatable<relocatable> : std::true_type {};
+} // namespace lyn
+
+template<std::size_t ChunkN>
+void segmented_vector_test() {
+    segmented_vector<std::string, ChunkN> seg;
+    std::vector<const std::string*> addresses;
+    for(int idx = 0; idx != 100; ++idx) addresses.push_back(&seg.push_back(std::to_string(idx)));
+    ASSERT_EQ(seg.size(), std::size_t{100});
+    ASSERT_EQ(seg.chunk_count(), (std::size_t{100} + ChunkN - 1) / ChunkN);
+    std::size_t in_chunks = 0;
+    for(std::size_t idx = 0; idx != seg.size(); ++idx) {
+        assert(&seg[idx] == addresses[idx]); // nothing moved while growing
+        ASSERT_EQ(seg[idx], std::to_string(idx));
+    }
+    for(std::size_t idx = 0; idx != seg.chunk_count(); ++idx) {
+        auto chunk = seg.chunk(idx);
+        ASSERT_EQ(chunk[0], std::to_string(in_chunks));
+        in_chunks += chunk.size();
+    }
+    ASSERT_EQ(in_chunks, seg.size());
+    ASSERT_EQ(std::distance(seg.begin(), seg.end()), std::ptrdiff_t{100});
+    ASSERT_EQ(*(seg.end() - 1), std::string("99"));
+    ASSERT_EQ(seg.cbegin()[42], std::string("42"));
+
+    auto copy = seg;
+    assert(copy == seg);
+    std::sort(copy.begin(), copy.end());
+    assert(copy != seg);
+    ASSERT_EQ(copy.front(), std::string("0"));
+    ASSERT_EQ(copy.back(), std::string("99"));
+    auto moved = std::move(copy);
+    assert(copy.empty());
+    ASSERT_EQ(moved.size(), std::size_t{100});
+
+    const auto capacity = seg.capacity();
+    while(seg.size() != 1) seg.pop_back();
+    ASSERT_EQ(seg.capacity(), capacity); // chunks are kept
+    ASSERT_EQ(seg.back(), std::string("0"));
+    seg.clear();
+    assert(seg.empty());
+    seg.shrink_to_fit();
+    ASSERT_EQ(seg.capacity(), std::size_t{0});
+    seg.reserve(2 * ChunkN + 1);
+    ASSERT_EQ(seg.capacity(), 3 * ChunkN);
+#ifndef LYNIPV_NO_EXCEPTIONS
+    bool ex = false;
+    try {
+        static_cast<void>(seg.at(0));
+    } catch(const std::out_of_range&) {
+        ex = true;
+    }
+    assert(ex);
+#endif
+}
+
+// every count up to N, with and without duplicates, probed at, between and outside the keys
+template<std::size_t N>
+void eytzinger_matches_lower_bound() {
+    for(std::size_t count = 0; count <= N; ++count) {
+        for(int dup = 1; dup <= 2; ++dup) {
+            inplace_vector<int, N> sorted;
+            for(std::size_t idx = 0; idx != count; ++idx) sorted.push_back(static_cast<int>(idx) / dup * 2);
+            const inplace_eytzinger<int, N> index(sorted);
+            ASSERT_EQ(index.size(), count);
+            assert(index.sorted() == sorted);
+            for(int key = -1; key <= static_cast<int>(2 * count) + 1; ++key) {
+                const auto expected = std::lower_bound(sorted.begin(), sorted.end(), key);
+                const auto rank = index.rank(key);
+                ASSERT_EQ(rank, static_cast<std::size_t>(expected - sorted.begin()));
+                const auto it = index.lower_bound(key);
+                ASSERT_EQ(index.rank(it), rank);
+                assert(it == index.end() ? expected == sorted.end() : *it == *expected);
+                ASSERT_EQ(index.contains(key), std::binary_search(sorted.begin(), sorted.end(), key));
+            }
+        }
+    }
+}
+
+// lyn::erase and lyn::erase_if against std::remove for sizes around the register widths
+template<class T>
+void erase_matches_std() {
+    unsigned seed = 12345;
+    for(std::size_t count = 0; count != 70; ++count) {
+        inplace_vector<T, 70> vec;
+        for(std::size_t idx = 0; idx != count; ++idx) {
+            seed = seed * 1103515245U + 12345U;
+            vec.push_back(static_cast<T>((seed >> 16) % 4));
+        }
+        for(int value = 0; value != 4; ++value) {
+            std::vector<T> expected(vec.begin(), vec.end());
+            expected.erase(std::remove(expected.begin(), expected.end(), static_cast<T>(value)), expected.end());
+            auto copy = vec;
+            const auto removed = lyn::erase(copy, static_cast<T>(value));
+            ASSERT_EQ(removed, vec.size() - expected.size());
+            assert(copy.size() == expected.size() && std::equal(expected.begin(), expected.end(), copy.begin()));
+
+            copy = vec;
+            std::size_t calls = 0;
+            const auto removed_if = lyn::erase_if(copy, [&](const T& elem) {
+                ++calls;
+                return elem == static_cast<T>(value);
+            });
+            ASSERT_EQ(calls, vec.size());
+            ASSERT_EQ(removed_if, removed);
+            assert(copy.size() == expected.size() && std::equal(expected.begin(), expected.end(), copy.begin()));
+        }
+    }
+}
+
+#if __cplusplus >= 202002L
+constexpr bool constexpr_erase() {
+    inplace_vector<int, 20> vec{1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3};
+    return lyn::erase(vec, 2) == 6 && lyn::erase_if(vec, [](int val) { return val == 3; }) == 6 && vec.size() == 6;
+}
+
+constexpr bool constexpr_checkpoint() {
+    inplace_vector<int, 8> vec{1, 2};
+    const auto mark = vec.checkpoint();
+    {
+        auto guard = vec.scoped_checkpoint();
+        vec.push_back(3);
+    }
+    vec.push_back(4);
+    const bool kept = vec.size() == 3 && vec.back() == 4;
+    vec.rollback(mark);
+    return kept && vec.size() == 2;
+}
+#endif
+
+// counts the subsets of items[idx..] that add up to sum by depth first search, with the chosen items on a
+// stack that each level rolls back with a checkpoint guard
+template<std::size_t N>
+int subsets_with_sum(inplace_vector<int, N>& chosen, const std::vector<int>& items, std::size_t idx, int sum) {
+    if(sum == 0) return 1;
+    if(sum < 0 || idx == items.size()) return 0;
+    auto guard = chosen.scoped_checkpoint();
+    chosen.push_back(items[idx]);
+    const int with = subsets_with_sum(chosen, items, idx + 1, sum - items[idx]);
+    guard.rollback();
+    ASSERT_EQ(chosen.size(), guard.checkpoint().size());
+    return with + subsets_with_sum(chosen, items, idx + 1, sum);
+}
+
+// not a template on the capacity, called with inplace_vectors of different capacities below
+std::size_t append_words(inplace_vector_ref<std::string> words, const std::string& text) {
+    std::istringstream is(text);
+    std::string word;
+    std::size_t added = 0;
+    while(is >> word && words.try_push_back(std::move(word))) ++added;
+    return added;
+}
+
+// a bump allocator handing out regions of one buffer, as the arena of a thread would
+class arena {
+public:
+    explicit arena(std::size_t bytes) : m_buffer(new unsigned char[bytes]), m_size(bytes) {}
+    template<class T>
+    void* take(std::size_t count) {
+        m_used = (m_used + alignof(T) - 1) / alignof(T) * alignof(T);
+        void* rv = m_buffer.get() + m_used;
+        m_used += count * sizeof(T);
+        assert(m_used <= m_size);
+        return rv;
+    }
+
+private:
+    std::unique_ptr<unsigned char[]> m_buffer;
+    std::size_t m_size;
+    std::size_t m_used = 0;
+};
+
+// many span_vectors of different capacities packed next to each other in one arena, so that writing
+// past the capacity of one would corrupt its neighbour
+void span_vector_arena_test() {
+    arena mem(1 << 16);
+    std::vector<span_vector<std::string>> vecs; // moved around when the std::vector grows
+    for(std::size_t idx = 0; idx != 50; ++idx) {
+        const auto capacity = idx % 7 + 1;
+        vecs.emplace_back(mem.take<std::string>(capacity), capacity);
+    }
+    const std::string tail(32, '.'); // long enough to be allocated, so that leaks are caught
+    for(std::size_t idx = 0; idx != vecs.size(); ++idx) {
+        auto& vec = vecs[idx];
+        while(vec.try_push_back(std::to_string(idx) + tail)) {
+        }
+        ASSERT_EQ(vec.size(), vec.capacity());
+        vec.erase(vec.begin() + (vec.size() > 2 ? 1 : 0));
+        vec.insert(vec.begin(), std::to_string(idx));
+    }
+    for(std::size_t idx = 0; idx != vecs.size(); ++idx) {
+        const auto& vec = vecs[idx];
+        ASSERT_EQ(vec.size(), idx % 7 + 1);
+        ASSERT_EQ(vec.front(), std::to_string(idx));
+        for(auto it = vec.begin() + 1; it != vec.end(); ++it) ASSERT_EQ(*it, std::to_string(idx) + tail);
+    }
+
+    // through inplace_vector_ref, like the inplace_vectors of different capacities
+    span_vector<std::string> words(mem.take<std::string>(4), 4);
+    const auto added = append_words(words, "a b c d e");
+    ASSERT_EQ(added, std::size_t{4});
+
+    span_vector<std::string> spare(mem.take<std::string>(6), 6, {"x", "y"});
+    const auto first_moved = spare.splice_back(words, words.begin() + 1, words.begin() + 3);
+    ASSERT_EQ(*first_moved, std::string("b"));
+    assert((spare == span_vector<std::string>(mem.take<std::string>(4), 4, {"x", "y", "b", "c"})));
+    ASSERT_EQ(words.size(), std::size_t{2});
+    ASSERT_EQ(words.back(), std::string("d"));
+
+    span_vector<relocatable> rel(mem.take<relocatable>(4), 4);
+    span_vector<relocatable> rel_other(mem.take<relocatable>(4), 4);
+    for(int val = 0; val != 4; ++val) rel.emplace_back(val);
+    rel_other.splice_back(rel, rel.begin(), rel.begin() + 3);
+    ASSERT_EQ(rel.size(), std::size_t{1});
+    ASSERT_EQ(*rel.front().value, 3);
+    ASSERT_EQ(*rel_other.back().value, 2);
+
+    auto taken = std::move(spare);
+    ASSERT_EQ(spare.capacity(), std::size_t{0});
+    ASSERT_EQ(taken.size(), std::size_t{4});
+    words = taken; // copied into the buffer of words, which has room for 4
+    ASSERT_EQ(words.capacity(), std::size_t{4});
+    assert(words == taken);
+#ifndef LYNIPV_NO_EXCEPTIONS
+    bool ex = false;
+    try {
+        taken.push_back("z");
+        taken.push_back("z");
+        taken.push_back("z");
+    } catch(const std::bad_alloc&) {
+        ex = true;
+    }
+    assert(ex);
+    ASSERT_EQ(taken.size(), std::size_t{6});
+    ex = false;
+    try {
+        words = taken;
+    } catch(const std::bad_alloc&) {
+        ex = true;
+    }
+    assert(ex);
+#endif
+}
+
+// random operations at both ends and in the middle, checked against std::vector, with N small enough to
+// recenter often
+template<class T, class Make>
+void devector_random_ops(Make make) {
+    inplace_devector<T, 24> dv;
+    std::vector<T> ref;
+    unsigned state = 7;
+    for(int op = 0; op != 20000; ++op) {
+        state = state * 1103515245U + 12345U;
+        const auto pos = ref.empty() ? 0 : static_cast<std::size_t>((state >> 20) % (ref.size() + 1));
+        const T value = make(op);
+        switch((state >> 8) % 9) {
+        case 0:
+            if(dv.try_push_back(value)) ref.push_back(value);
+            break;
+        case 1:
+            if(dv.try_push_front(value)) ref.insert(ref.begin(), value);
+            break;
+        case 2:
+            if(!ref.empty()) {
+                dv.pop_back();
+                ref.pop_back();
+            }
+            break;
+        case 3:
+            if(!ref.empty()) {
+                dv.pop_front();
+                ref.erase(ref.begin());
+            }
+            break;
+        case 4:
+            if(!dv.full()) {
+                const auto it = dv.insert(dv.begin() + pos, value);
+                ASSERT_EQ(static_cast<std::size_t>(it - dv.begin()), pos);
+                ref.insert(ref.begin() + static_cast<std::ptrdiff_t>(pos), value);
+            }
+            break;
+        case 5:
+            if(pos < ref.size()) {
+                dv.erase(dv.begin() + pos);
+                ref.erase(ref.begin() + static_cast<std::ptrdiff_t>(pos));
+            }
+            break;
+        case 6: {
+            const std::vector<T> range{value, make(-op), value};
+            const auto count = static_cast<std::size_t>((state >> 4) % 4);
+            if(ref.size() + count <= dv.capacity()) {
+                dv.insert(dv.begin() + pos, range.begin(), range.begin() + count);
+                ref.insert(ref.begin() + static_cast<std::ptrdiff_t>(pos), range.begin(), range.begin() + count);
+            }
+            break;
+        }
+        case 7: {
+            const auto count = std::min<std::size_t>(ref.size() - pos, (state >> 4) % 5);
+            dv.erase(dv.begin() + pos, dv.begin() + pos + count);
+            ref.erase(ref.begin() + static_cast<std::ptrdiff_t>(pos), ref.begin() + static_cast<std::ptrdiff_t>(pos + count));
+            break;
+        }
+        default:
+            // the argument is an element that may be moved to make room
+            if(!ref.empty() && !dv.full()) {
+                dv.push_front(dv.back());
+                ref.insert(ref.begin(), ref.back());
+            }
+        }
+        ASSERT_EQ(dv.size(), ref.size());
+        ASSERT_EQ(dv.front_free_capacity() + dv.size() + dv.back_free_capacity(), dv.capacity());
+        assert(std::equal(ref.begin(), ref.end(), dv.data()));
+    }
+}
+
 int main() {
     validate<int>();
     validate<std::string>();
@@ -354,6 +969,7 @@ int main() {
     }
     std::cout << "--- exception\n";
     {
+#ifndef LYNIPV_NO_EXCEPTIONS
         bool ex = false;
         try {
             iv.emplace(iv.begin());
@@ -361,6 +977,7 @@ int main() {
             ex = true;
         }
         assert(ex == true);
+#endif
         assert(iv.try_push_back("nope") == nullptr);
         assert(iv.try_emplace_back("nope") == nullptr);
     }
@@ -375,6 +992,557 @@ int main() {
         assert(iv.size() == 4);
         assert(iv == copy);
     }
+    std::cout << "--- assignment reuses elements\n";
+    {
+        using IV = inplace_vector<counted_string, 8>;
+        const counted_string xs(100, 'x');
+        IV src(6, xs);
+        IV dst(4, counted_string(100, 'y'));
+        auto before = allocations;
+        dst = src; // 4 copy assigned into existing buffers, 2 copy constructed
+        ASSERT_EQ(allocations - before, std::size_t{2});
+        assert(dst == src);
+
+        const IV shorter(2, counted_string(50, 'z'));
+        before = allocations;
+        dst = shorter; // 2 copy assigned, 4 destroyed
+        ASSERT_EQ(allocations - before, std::size_t{0});
+        assert(dst == shorter);
+
+        before = allocations;
+        dst = std::move(src); // 2 move assigned, 4 move constructed
+        ASSERT_EQ(allocations - before, std::size_t{0});
+        ASSERT_EQ(dst.size(), std::size_t{6});
+        ASSERT_EQ(src.size(), std::size_t{0});
+        assert(std::all_of(dst.begin(), dst.end(), [&](const counted_string& str) { return str == xs; }));
+
+        auto& self = dst;
+        dst = self;
+        ASSERT_EQ(dst.size(), std::size_t{6});
+        assert(dst[5] == xs);
+    }
+    std::cout << "--- conversions between capacities\n";
+    {
+        static_assert(std::is_convertible<const inplace_vector<int, 2>&, inplace_vector<int, 4>>::value, "");
+        static_assert(!std::is_convertible<const inplace_vector<int, 8>&, inplace_vector<int, 4>>::value, "");
+        static_assert(std::is_constructible<inplace_vector<int, 4>, const inplace_vector<int, 8>&>::value, "");
+        static_assert(std::is_convertible<inplace_vector<std::string, 2>&&, inplace_vector<std::string, 4>>::value, "");
+
+        const inplace_vector<int, 2> small{1, 2};
+        inplace_vector<int, 4> wider = small;
+        ASSERT_EQ(wider.size(), std::size_t{2});
+        wider.push_back(3);
+        inplace_vector<int, 3> narrower(wider);
+        assert(std::equal(wider.begin(), wider.end(), narrower.begin()));
+        wider.push_back(4);
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            narrower = wider;
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+        ASSERT_EQ(narrower.size(), std::size_t{3});
+#endif
+        narrower = small;
+        ASSERT_EQ(narrower.size(), std::size_t{2});
+
+        inplace_vector<std::string, 2> strs{"a", "b"};
+        inplace_vector<std::string, 4> moved(std::move(strs));
+        assert(strs.empty());
+        ASSERT_EQ(moved.back(), std::string("b"));
+        inplace_vector<std::string, 3> reused{"x", "y", "z"};
+        reused = moved; // copy assigns "a" and "b" over "x" and "y"
+        ASSERT_EQ(reused.size(), std::size_t{2});
+        ASSERT_EQ(reused.front(), std::string("a"));
+        strs = std::move(reused);
+        assert(reused.empty());
+        ASSERT_EQ(strs.back(), std::string("b"));
+
+        std::vector<std::string> source{"1", "2", "3"};
+        inplace_vector<std::string, 3> from_range(source.begin(), source.end());
+        assert(std::equal(source.begin(), source.end(), from_range.begin()));
+#ifndef LYNIPV_NO_EXCEPTIONS
+        ex = false;
+        try {
+            inplace_vector<std::string, 2> too_small(source.begin(), source.end());
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+    }
+    std::cout << "--- splice_back and split_at\n";
+    {
+        inplace_vector<std::string, 6> src{"a", "b", "c", "d", "e"};
+        inplace_vector<std::string, 3> dst{"x"};
+        auto it = dst.splice_back(src, src.begin() + 1, src.begin() + 3);
+        ASSERT_EQ(*it, std::string("b"));
+        assert((dst == inplace_vector<std::string, 3>{"x", "b", "c"}));
+        assert((src == inplace_vector<std::string, 6>{"a", "d", "e"}));
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            dst.splice_back(src, src.begin(), src.begin() + 1);
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+        ASSERT_EQ(src.size(), std::size_t{3});
+#endif
+        auto tail = src.split_at(src.begin() + 1);
+        assert((tail == inplace_vector<std::string, 6>{"d", "e"}));
+        ASSERT_EQ(src.size(), std::size_t{1});
+
+        inplace_vector<int, 8> ints{1, 2, 3, 4, 5, 6};
+        inplace_vector<int, 4> some;
+        some.splice_back(ints, ints.begin() + 2, ints.begin() + 4);
+        assert((some == inplace_vector<int, 4>{3, 4}));
+        assert((ints == inplace_vector<int, 8>{1, 2, 5, 6}));
+        auto ints_tail = ints.split_at(ints.begin() + 3);
+        assert((ints_tail == inplace_vector<int, 8>{6}));
+
+        inplace_vector<relocatable, 4> rel;
+        for(int idx = 0; idx != 4; ++idx) rel.emplace_back(idx);
+        inplace_vector<relocatable, 2> rel_dst;
+        rel_dst.splice_back(rel, rel.begin(), rel.begin() + 2);
+        ASSERT_EQ(*rel_dst[1].value, 1);
+        ASSERT_EQ(rel.size(), std::size_t{2});
+        ASSERT_EQ(*rel[0].value, 2);
+        auto rel_tail = rel.split_at(rel.begin() + 1);
+        ASSERT_EQ(*rel_tail[0].value, 3);
+        inplace_vector<relocatable, 8> rel_wide(std::move(rel_tail));
+        assert(rel_tail.empty());
+        ASSERT_EQ(*rel_wide[0].value, 3);
+    }
+    std::cout << "--- inplace_vector_ref\n";
+    {
+        inplace_vector<std::string, 3> three;
+        inplace_vector<std::string, 8> eight;
+        inplace_vector<std::string, 0> none;
+        const auto added_three = append_words(three, "a b c d e");
+        const auto added_eight = append_words(eight, "a b c d e");
+        const auto added_none = append_words(none, "a b c d e");
+        ASSERT_EQ(added_three, std::size_t{3});
+        ASSERT_EQ(added_eight, std::size_t{5});
+        ASSERT_EQ(added_none, std::size_t{0});
+        ASSERT_EQ(three.size(), std::size_t{3});
+        ASSERT_EQ(eight.back(), std::string("e"));
+
+        inplace_vector_ref<std::string> ref = eight;
+        ASSERT_EQ(ref.capacity(), std::size_t{8});
+        auto it = ref.insert(ref.begin() + 1, std::string("x"));
+        ASSERT_EQ(*it, std::string("x"));
+        ref.insert(ref.end(), 2, "y");
+        assert((eight == inplace_vector<std::string, 8>{"a", "x", "b", "c", "d", "e", "y", "y"}));
+        assert(!ref.try_emplace_back("z"));
+        it = ref.erase(ref.begin() + 2, ref.begin() + 5);
+        ASSERT_EQ(*it, std::string("e"));
+        it = ref.erase(ref.begin());
+        ASSERT_EQ(*it, std::string("x"));
+        assert((eight == inplace_vector<std::string, 8>{"x", "e", "y", "y"}));
+        ref.resize(6, "r");
+        ASSERT_EQ(eight.size(), std::size_t{6});
+        ASSERT_EQ(eight.back(), std::string("r"));
+        ref.resize(2);
+        assert((eight == inplace_vector<std::string, 8>{"x", "e"}));
+        ref.pop_back();
+        ASSERT_EQ(ref.size(), std::size_t{1});
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            ref.insert(ref.begin(), 8, "w");
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+        ex = false;
+        try {
+            static_cast<void>(ref.at(1));
+        } catch(const std::out_of_range&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+        ASSERT_EQ(eight.size(), std::size_t{1});
+        ref.clear();
+        assert(eight.empty());
+
+        inplace_vector<int, 4> ints{3, 1, 2};
+        inplace_vector_ref<int> iref = ints;
+        std::sort(iref.begin(), iref.end());
+        iref.emplace(iref.begin(), 0);
+        assert((ints == inplace_vector<int, 4>{0, 1, 2, 3}));
+        ASSERT_EQ(iref.at(3), 3);
+    }
+    std::cout << "--- span_vector\n";
+    span_vector_arena_test();
+    std::cout << "--- erase and erase_if\n";
+    {
+        erase_matches_std<int>();
+        erase_matches_std<unsigned>();
+        erase_matches_std<std::int64_t>();
+        erase_matches_std<float>();
+        erase_matches_std<double>();
+        erase_matches_std<short>();
+
+        // the comparison is ==, so NaN is never erased and 0.0 also erases -0.0
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        inplace_vector<float, 40> floats;
+        for(int idx = 0; idx != 20; ++idx) {
+            floats.push_back(nan);
+            floats.push_back(idx % 2 ? -0.0f : 0.0f);
+        }
+        const auto erased_nan = lyn::erase(floats, nan);
+        const auto erased_zero = lyn::erase(floats, 0.0f);
+        ASSERT_EQ(erased_nan, std::size_t{0});
+        ASSERT_EQ(erased_zero, std::size_t{20});
+        ASSERT_EQ(floats.size(), std::size_t{20});
+
+        // a value of another type than the elements is compared as such
+        inplace_vector<int, 40> ints(40, 3);
+        const auto erased_fraction = lyn::erase(ints, 3.5);
+        ASSERT_EQ(erased_fraction, std::size_t{0});
+
+        inplace_vector<std::string, 8> strs{"a", "b", "a", "c"};
+        const auto erased_a = lyn::erase(strs, "a");
+        ASSERT_EQ(erased_a, std::size_t{2});
+        const auto erased_c = lyn::erase_if(strs, [](const std::string& str) { return str == "c"; });
+        ASSERT_EQ(erased_c, std::size_t{1});
+        assert((strs == inplace_vector<std::string, 8>{"b"}));
+        inplace_vector<std::unique_ptr<int>, 4> ptrs;
+        ptrs.emplace_back(new int(1));
+        ptrs.emplace_back();
+        const auto erased_null = lyn::erase_if(ptrs, [](const std::unique_ptr<int>& ptr) { return !ptr; });
+        ASSERT_EQ(erased_null, std::size_t{1});
+#if __cplusplus >= 202002L
+        static_assert(constexpr_erase());
+#endif
+    }
+    std::cout << "--- checkpoint and rollback\n";
+    {
+        inplace_vector<int, 16> ints{1, 2, 3};
+        const auto outer = ints.checkpoint();
+        ints.push_back(4);
+        const auto inner = ints.checkpoint();
+        ASSERT_EQ(inner.size(), std::size_t{4});
+        ints.push_back(5);
+        ints.push_back(6);
+        ints.rollback(inner);
+        assert((ints == inplace_vector<int, 16>{1, 2, 3, 4}));
+        ints.rollback(inner); // rolling back to the same marker again does nothing
+        ints.rollback(outer);
+        assert((ints == inplace_vector<int, 16>{1, 2, 3}));
+
+        {
+            auto committed = ints.scoped_checkpoint();
+            ints.push_back(7);
+            {
+                auto discarded = ints.scoped_checkpoint();
+                ints.push_back(8);
+            }
+            committed.commit();
+            committed.rollback(); // does nothing once committed
+        }
+        assert((ints == inplace_vector<int, 16>{1, 2, 3, 7}));
+        {
+            inplace_vector<int, 16>::checkpoint_guard guard(ints);
+            ints.push_back(9);
+            ints[0] = 0; // only the size is restored
+        }
+        assert((ints == inplace_vector<int, 16>{0, 2, 3, 7}));
+
+        inplace_vector<int, 8> chosen;
+        const std::vector<int> items{3, 5, 2, 8, 1, 4};
+        const int subsets = subsets_with_sum(chosen, items, 0, 9);
+        ASSERT_EQ(subsets, 4); // 3+5+1, 3+2+4, 5+4 and 8+1
+        assert(chosen.empty());
+
+        // elements with destructors are destroyed by the rollback
+        auto shared = std::make_shared<int>(1);
+        inplace_vector<std::shared_ptr<int>, 8> ptrs{shared};
+        {
+            auto guard = ptrs.scoped_checkpoint();
+            ptrs.push_back(shared);
+            ptrs.push_back(shared);
+            ASSERT_EQ(shared.use_count(), 4L);
+        }
+        ASSERT_EQ(shared.use_count(), 2L);
+        ASSERT_EQ(ptrs.size(), std::size_t{1});
+#if __cplusplus >= 202002L
+        static_assert(constexpr_checkpoint());
+#endif
+    }
+    std::cout << "--- segmented_vector\n";
+    {
+        segmented_vector_test<8>();
+        segmented_vector_test<3>();
+        segmented_vector<int, 4> ints{5, 4, 3, 2, 1};
+        ASSERT_EQ(ints.chunk(1).size(), std::size_t{1});
+        ASSERT_EQ(ints.chunk(1)[0], 1);
+    }
+    std::cout << "--- inplace_eytzinger\n";
+    {
+        eytzinger_matches_lower_bound<40>();
+        eytzinger_matches_lower_bound<1>();
+
+        const std::list<std::string> words{"delta", "bravo", "alpha"};
+        const inplace_eytzinger<std::string, 4, std::greater<std::string>> index(words.begin(), words.end());
+        ASSERT_EQ(*index.begin(), std::string("bravo")); // the root is the middle key
+        ASSERT_EQ(index.rank(std::string("charlie")), std::size_t{1});
+        assert(index.contains("alpha"));
+        assert(!index.contains("echo"));
+        ASSERT_EQ(index.rank(std::string("aardvark")), std::size_t{3});
+        assert(index.lower_bound("aardvark") == index.end());
+#ifndef LYNIPV_NO_EXCEPTIONS
+        const std::vector<int> five{1, 2, 3, 4, 5};
+        bool ex = false;
+        try {
+            inplace_eytzinger<int, 4> small(five.begin(), five.end());
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+    }
+    std::cout << "--- inplace_lru_cache\n";
+    {
+        inplace_lru_cache<int, int, 8> small;
+        lru_cache_random_ops(small);
+        inplace_lru_cache<int, int, 40, colliding_hash> colliding;
+        lru_cache_random_ops(colliding);
+
+        inplace_lru_cache<std::string, std::unique_ptr<int>, 2> ptrs;
+        const int first = *ptrs.get_or_emplace("a", [] { return std::unique_ptr<int>(new int(1)); });
+        ASSERT_EQ(first, 1);
+        ptrs.put("b", std::unique_ptr<int>(new int(2)));
+        assert(ptrs.get("a") != nullptr); // "b" is now the least recently used
+        ptrs.put("c", std::unique_ptr<int>(new int(3)));
+        assert(!ptrs.contains("b"));
+        ASSERT_EQ(ptrs.begin()->first, std::string("c"));
+        ASSERT_EQ(std::prev(ptrs.end())->first, std::string("a"));
+        const int* a_value = ptrs.peek("a")->get();
+        auto moved = std::move(ptrs);
+        assert(ptrs.empty());
+        ASSERT_EQ(moved.peek("a")->get(), a_value);
+        ASSERT_EQ(moved.begin()->first, std::string("c")); // the order is kept
+
+        // the value refers to the entry that the insertion evicts
+        inplace_lru_cache<int, std::string, 1> single;
+        single.put(1, std::string("long enough to be allocated on the heap"));
+        single.put(2, *single.peek(1));
+        ASSERT_EQ(*single.peek(2), std::string("long enough to be allocated on the heap"));
+        const std::string& copied = single.get_or_emplace(3, [&single] { return *single.peek(2); });
+        ASSERT_EQ(copied, std::string("long enough to be allocated on the heap"));
+        assert(!single.contains(2));
+        // and the key refers to it
+        inplace_lru_cache<std::string, std::string, 1> chain;
+        chain.put("first", "the value that the next entry uses as its key");
+        const std::string& chained = chain.put(*chain.peek("first"), "second");
+        ASSERT_EQ(chained, std::string("second"));
+        assert(chain.contains("the value that the next entry uses as its key"));
+        auto moved_chain = std::move(chain);
+        assert(chain.empty() && moved_chain.contains("the value that the next entry uses as its key"));
+
+        inplace_lru_cache<std::string, std::string, 3> strs;
+        strs.put("x", "1");
+        strs.put("y", "2");
+        auto copy = strs;
+        strs.put("x", "3");
+        ASSERT_EQ(*copy.peek("x"), std::string("1"));
+        ASSERT_EQ(copy.begin()->first, std::string("y"));
+        copy = strs;
+        ASSERT_EQ(*copy.peek("x"), std::string("3"));
+        ASSERT_EQ(copy.begin()->first, std::string("x"));
+#ifndef LYNIPV_NO_EXCEPTIONS
+        strs.put("z", "4");
+        bool ex = false;
+        try {
+            strs.get_or_emplace("w", []() -> std::string { throw std::runtime_error("factory"); });
+        } catch(const std::runtime_error&) {
+            ex = true;
+        }
+        assert(ex);
+        ASSERT_EQ(strs.size(), std::size_t{3}); // nothing was evicted
+        assert(!strs.contains("w"));
+#endif
+    }
+    std::cout << "--- inplace_packed_vector\n";
+    {
+        packed_vector_random_ops<1>();
+        packed_vector_random_ops<2>();
+        packed_vector_random_ops<3>();
+        packed_vector_random_ops<4>();
+        packed_vector_random_ops<7>();
+        packed_vector_random_ops<32>();
+
+        static_assert(sizeof(inplace_bit_vector<128>) == 2 * sizeof(std::uint64_t) + sizeof(std::size_t), "");
+        inplace_bit_vector<100> lhs(100), rhs(100);
+        for(std::size_t idx = 0; idx < 100; idx += 3) lhs[idx] = true;
+        for(std::size_t idx = 0; idx < 100; idx += 5) rhs[idx] = true;
+        ASSERT_EQ((lhs & rhs).count(), std::size_t{7});  // multiples of 15
+        ASSERT_EQ((lhs | rhs).count(), std::size_t{47}); // 34 + 20 - 7
+        ASSERT_EQ((lhs ^ rhs).count(), std::size_t{40});
+        lhs.flip();
+        ASSERT_EQ(lhs.count(), std::size_t{66});
+        ASSERT_EQ(lhs.count(false), std::size_t{34});
+        ASSERT_EQ(lhs.find_first(), std::size_t{1});
+        ASSERT_EQ(lhs.find_next(96), std::size_t{97});
+        ASSERT_EQ(lhs.find_next(99), inplace_bit_vector<100>::npos);
+        swap(lhs[0], lhs[1]);
+        assert(lhs[0] && !lhs[1]);
+        lhs.resize(64);
+        ASSERT_EQ(lhs.word_size(), std::size_t{1});
+
+        enum class code : unsigned char { a, b, c, d };
+        inplace_packed_vector<2, 10, code> codes{code::d, code::a, code::c};
+        ASSERT_EQ(codes.count(code::c), std::size_t{1});
+        assert(codes[0] == code::d);
+        codes.back() = code::b;
+        ASSERT_EQ(codes.find_first(code::b), std::size_t{2});
+        ASSERT_EQ(codes.word_data()[0], std::uint64_t{0x13}); // d = 3, a = 0 and b = 1, 2 bits each
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            static_cast<void>(codes.at(3));
+        } catch(const std::out_of_range&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+    }
+#if __cplusplus >= 201703L
+    std::cout << "--- inplace_memory_resource\n";
+    {
+        inplace_memory_resource<1024> arena(std::pmr::null_memory_resource());
+        {
+            std::pmr::vector<int> ints(&arena);
+            ints.reserve(100);
+            ASSERT_EQ(arena.bytes_used(), std::size_t{512}); // the size class of 400 bytes
+            ints.assign(100, 7);
+        } // the vector was the last block, so the bump pointer moves back
+        ASSERT_EQ(arena.bytes_used(), std::size_t{0});
+        ASSERT_EQ(arena.high_water_mark(), std::size_t{512});
+
+        // small blocks are rounded up to their size class and reused
+        void* small = arena.allocate(24, 8);
+        void* pinned = arena.allocate(100, 8); // keeps small from being the last block
+        arena.deallocate(small, 24, 8);
+        void* reused = arena.allocate(20, 4);
+        ASSERT_EQ(reused, small);
+        ASSERT_EQ(arena.bytes_used(), std::size_t{32 + 128});
+        arena.deallocate(reused, 20, 4);
+        arena.deallocate(pinned, 100, 8);
+        ASSERT_EQ(arena.bytes_used(), std::size_t{32});
+
+        const auto used_before_churn = arena.bytes_used();
+        arena.reset_statistics();
+        for(int round = 0; round != 1000; ++round) {
+            std::pmr::string str(40, 'x', &arena);
+            std::pmr::vector<std::pmr::string> strs(&arena);
+            strs.emplace_back(str);
+        }
+        ASSERT_EQ(arena.high_water_mark() - used_before_churn, std::size_t{3 * 64}); // the three blocks of every round
+        ASSERT_EQ(arena.bytes_used(), used_before_churn);
+        ASSERT_EQ(arena.upstream_fallbacks(), std::size_t{0});
+
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            static_cast<void>(arena.allocate(2000, 8));
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+        arena.release();
+        ASSERT_EQ(arena.bytes_used(), std::size_t{0});
+
+        inplace_memory_resource<256, 64, false> overflow;
+        const auto first_addr = reinterpret_cast<std::uintptr_t>(overflow.allocate(8, 8));
+        ASSERT_EQ(first_addr % 64, std::uintptr_t{0});
+        std::pmr::vector<std::int64_t> big(100, 1, &overflow); // goes upstream
+        ASSERT_EQ(overflow.upstream_fallbacks(), std::size_t{1});
+        ASSERT_EQ(overflow.upstream_bytes(), sizeof(std::int64_t) * 100);
+        ASSERT_EQ(overflow.bytes_used(), std::size_t{8});
+        overflow.reset_statistics();
+        ASSERT_EQ(overflow.upstream_fallbacks(), std::size_t{0});
+        assert(overflow == overflow && !(overflow == arena));
+    }
+#endif
+    std::cout << "--- inplace_devector\n";
+    {
+        devector_random_ops<int>([](int value) { return value; });
+        devector_random_ops<std::string>([](int value) { return std::to_string(value) + " is too long to be a short string"; });
+
+        // headers prepended to a payload without moving it
+        inplace_devector<char, 32> packet;
+        packet.recenter(8);
+        ASSERT_EQ(packet.front_free_capacity(), std::size_t{8});
+        const std::string payload = "payload";
+        packet.insert(packet.end(), payload.begin(), payload.end());
+        const char* payload_addr = packet.data();
+        packet.insert(packet.begin(), {'t', 'c', 'p'});
+        packet.insert(packet.begin(), {'i', 'p'});
+        ASSERT_EQ(std::string(packet.begin(), packet.end()), std::string("iptcppayload"));
+        assert(packet.data() + 5 == payload_addr);
+        ASSERT_EQ(packet.front_free_capacity(), std::size_t{3});
+        packet.clear(); // keeps the position, and recentering an empty devector moves nothing
+        ASSERT_EQ(packet.front_free_capacity(), std::size_t{3});
+        packet.recenter(8);
+        ASSERT_EQ(packet.back_free_capacity(), std::size_t{24});
+
+        // running out of room at the front recenters, splitting what is left
+        inplace_devector<int, 8> ints{1, 2, 3};
+        ASSERT_EQ(ints.front_free_capacity(), std::size_t{0});
+        ints.push_front(0);
+        ASSERT_EQ(ints.front_free_capacity(), std::size_t{2});
+        ASSERT_EQ(ints.back_free_capacity(), std::size_t{2});
+        ints.recenter(4);
+        ASSERT_EQ(ints.back_free_capacity(), std::size_t{0});
+        ints.push_back(4); // and at the back
+        ASSERT_EQ(ints.front_free_capacity(), std::size_t{1});
+        ints.insert(ints.begin() + 2, 2, 9);
+        assert((ints == inplace_devector<int, 8>{0, 1, 9, 9, 2, 3, 4}));
+        ints.insert(ints.end(), 1, ints.front()); // full after this
+        assert(ints.full());
+        assert(ints.try_emplace_front(5) == nullptr);
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            ints.recenter(1);
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+        const auto erased_nines = erase(ints, 9);
+        ASSERT_EQ(erased_nines, std::size_t{2});
+        const auto erased_small = erase_if(ints, [](int value) { return value < 2; });
+        ASSERT_EQ(erased_small, std::size_t{3});
+        assert((ints == inplace_devector<int, 8>{2, 3, 4}));
+        ints.resize(5, 6);
+        ints.resize(4);
+        assert((ints == inplace_devector<int, 8>{2, 3, 4, 6}));
+        assert((ints < inplace_devector<int, 8>{2, 3, 5}));
+
+        std::istringstream numbers("7 8 9");
+        ints.insert(ints.begin() + 1, std::istream_iterator<int>(numbers), std::istream_iterator<int>());
+        assert((ints == inplace_devector<int, 8>{2, 7, 8, 9, 3, 4, 6}));
+
+        inplace_devector<std::unique_ptr<int>, 4> ptrs;
+        ptrs.emplace_front(new int(2));
+        ptrs.emplace_front(new int(1));
+        ptrs.emplace_back(new int(3));
+        auto moved = std::move(ptrs);
+        assert(ptrs.empty());
+        ASSERT_EQ(*moved.front(), 1);
+        ASSERT_EQ(*moved.back(), 3);
+        moved.erase(moved.begin());
+        ASSERT_EQ(*moved.front(), 2);
+    }
+
     std::cout << "--- comparisons\n";
     {
         iv.clear();
@@ -476,6 +1644,305 @@ int main() {
         for(auto& v : foo) std::cout << v << '\n';
     }
 
+    std::cout << "--- inplace_top_k\n";
+    {
+        std::vector<int> in;
+        unsigned seed = 12345;
+        for(int i = 0; i < 1000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            in.push_back(static_cast<int>(seed >> 16) % 500);
+        }
+        auto expected = in;
+        std::sort(expected.begin(), expected.end(), std::greater<int>{});
+
+        inplace_top_k<int, 10> batch;
+        batch.offer(in.begin(), in.end());
+        assert(batch.full());
+        ASSERT_EQ(batch.top(), expected[9]);
+        auto best = batch.sorted_drain();
+        assert(batch.empty());
+        assert(std::equal(best.begin(), best.end(), expected.begin()));
+
+        inplace_top_k<int, 10> single;
+        for(int v : in) single.offer(v);
+        assert(single.sorted_drain() == best);
+
+        inplace_top_k<int, 7, std::greater<int>> least;
+        least.offer(in.data(), in.data() + in.size());
+        auto lowest = least.sorted_drain();
+        std::sort(expected.begin(), expected.end());
+        assert(std::equal(lowest.begin(), lowest.end(), expected.begin()));
+
+        inplace_top_k<std::string, 2> strs;
+        assert(strs.offer("b"));
+        assert(strs.offer("a"));
+        assert(!strs.offer("a"));
+        assert(strs.offer("c"));
+        ASSERT_EQ(strs.top(), std::string("b"));
+        strs.replace_top("d");
+        ASSERT_EQ(strs.top(), std::string("c"));
+        auto sorted = strs.sorted_drain();
+        ASSERT_EQ(sorted, (inplace_vector<std::string, 2>{"d", "c"}));
+    }
+
+    std::cout << "--- inplace_string\n";
+    {
+        static_assert(sizeof(inplace_string<15>) == 16, "size not stored in the last byte");
+        static_assert(sizeof(inplace_string<300>) == sizeof(std::size_t) + 304, "size stored separately");
+        static_assert(std::is_trivially_copyable<inplace_string<15>>::value, "");
+
+        inplace_string<15> str;
+        assert(str.empty());
+        ASSERT_EQ(std::string(str.c_str()), std::string(""));
+        str = "Hello";
+        str.append(", ").append("world");
+        str += '!';
+        ASSERT_EQ(str.size(), std::size_t{13});
+        ASSERT_EQ(std::string(str.c_str()), std::string("Hello, world!"));
+        ASSERT_EQ(str.find("world"), std::size_t{7});
+        ASSERT_EQ(str.find('o'), std::size_t{4});
+        ASSERT_EQ(str.rfind('o'), std::size_t{8});
+        ASSERT_EQ(str.find("word"), inplace_string<15>::npos);
+        assert(str.try_append("ab", 2));
+        ASSERT_EQ(str.size(), std::size_t{15});
+        ASSERT_EQ(str[15], '\0'); // the remaining capacity, 0, is the terminator
+        assert(!str.try_append("c", 1));
+        ASSERT_EQ(std::string(str.c_str()), std::string("Hello, world!ab"));
+        str.pop_back();
+        ASSERT_EQ(std::string(str.c_str()), std::string("Hello, world!a"));
+        str.resize(5);
+        assert(str == "Hello");
+        assert(!(str == "Hell"));
+        assert(str.compare("Help") < 0);
+
+        inplace_string<300> big(200, 'x');
+        ASSERT_EQ(big.size(), std::size_t{200});
+        ASSERT_EQ(big.c_str()[200], '\0');
+        inplace_string<15> a("abc");
+        inplace_string<300> b("abd");
+        assert(a != b);
+        assert(a < b);
+        assert(b > a);
+        std::ostringstream os;
+        os << a;
+        ASSERT_EQ(os.str(), std::string("abc"));
+
+        std::unordered_set<inplace_string<15>> set{"one", "two", "three"};
+        assert(set.count("two") == 1);
+        assert(set.count("four") == 0);
+#if __cplusplus >= 201703L
+        std::string_view sv = a;
+        assert(sv == "abc");
+        assert(std::hash<inplace_string<15>>{}(a) == std::hash<std::string>{}("abc"));
+#endif
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            a.append(13, 'x');
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+        assert(a == "abc");
+#endif
+    }
+
+    std::cout << "--- inplace_list\n";
+    {
+        static_assert(std::is_same<std::iterator_traits<inplace_list<int, 4>::iterator>::iterator_category,
+                                   std::bidirectional_iterator_tag>::value,
+                      "");
+        inplace_list<std::string, 5> lst{"b", "c", "d"};
+        auto b = lst.begin();
+        auto c = std::next(b);
+        const std::string* caddr = &*c;
+        lst.push_front("a");
+        lst.emplace_back("e");
+        assert(lst.full());
+        assert(lst.try_emplace_back("f") == nullptr);
+        ASSERT_EQ(lst.front(), std::string("a"));
+        ASSERT_EQ(lst.back(), std::string("e"));
+        assert(&*c == caddr); // stable across insert
+
+        lst.erase(b);
+        assert(&*c == caddr); // and erase
+        ASSERT_EQ(*c, std::string("c"));
+        lst.emplace(c, "b2"); // reuses the freed slot
+        assert(std::equal(lst.begin(), lst.end(), std::vector<std::string>{"a", "b2", "c", "d", "e"}.begin()));
+        assert(std::equal(lst.rbegin(), lst.rend(), std::vector<std::string>{"e", "d", "c", "b2", "a"}.begin()));
+
+        // within the list: move "d", "e" to the front
+        lst.splice(lst.begin(), lst, std::next(c), lst.end());
+        assert(std::equal(lst.begin(), lst.end(), std::vector<std::string>{"d", "e", "a", "b2", "c"}.begin()));
+        assert(&*c == caddr);
+
+        inplace_list<std::string, 5> other{"x"};
+        other.splice(other.end(), lst, c);
+        ASSERT_EQ(lst.size(), std::size_t{4});
+        ASSERT_EQ(other.size(), std::size_t{2});
+        ASSERT_EQ(other.back(), std::string("c"));
+
+        auto copy = lst;
+        assert(copy == lst);
+        lst.pop_front();
+        lst.pop_back();
+        assert(copy != lst);
+        copy = lst;
+        assert(copy == lst);
+        auto moved = std::move(copy);
+        assert(copy.empty());
+        assert(moved == lst);
+        swap(moved, other);
+        ASSERT_EQ(moved.size(), std::size_t{2});
+        ASSERT_EQ(other.size(), std::size_t{2});
+        other.clear();
+        assert(other.empty());
+        inplace_list<int, 3> ints(3, 7);
+        ASSERT_EQ(ints.back(), 7);
+        ints.assign({1, 2});
+        ASSERT_EQ(ints.size(), std::size_t{2});
+        ASSERT_EQ(ints.back(), 2);
+    }
+
+    std::cout << "--- inplace_slot_map\n";
+    {
+        inplace_slot_map<std::string, 3> map;
+        assert(!map.contains(inplace_slot_map_handle{}));
+        auto a = map.insert("a");
+        auto b = map.emplace(1, 'b');
+        auto c = map.insert(std::string("c"));
+        assert(map.full());
+        assert(!map.try_emplace("d").second);
+        ASSERT_EQ(map[b], std::string("b"));
+
+        assert(map.erase(a)); // "c" is moved into the hole
+        assert(!map.erase(a));
+        assert(map.find(a) == nullptr);
+        ASSERT_EQ(map.at(c), std::string("c"));
+        ASSERT_EQ(map.size(), std::size_t{2});
+        auto d = map.insert("d"); // reuses the slot of "a"
+        ASSERT_EQ(d.index, a.index);
+        assert(d != a);
+        assert(!map.contains(a));
+        ASSERT_EQ(*map.find(d), std::string("d"));
+        for(auto it = map.begin(); it != map.end(); ++it) assert(&map[map.handle_of(it)] == &*it);
+
+        auto copy = map;
+        ASSERT_EQ(copy[c], std::string("c"));
+        auto moved = std::move(copy);
+        assert(copy.empty());
+        assert(!copy.contains(c));
+        ASSERT_EQ(moved[d], std::string("d"));
+        map.clear();
+        assert(map.empty());
+        assert(!map.contains(b));
+        auto e = map.insert("e");
+        assert(e != b && e != c && e != d);
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            map.at(b);
+        } catch(const std::out_of_range&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+    }
+
+    std::cout << "--- inplace_unordered_map\n";
+    {
+        static_assert(inplace_unordered_map<int, int, 64>::bucket_count() == 128, "");
+        static_assert(inplace_unordered_map<int, int, 3>::bucket_count() == 16, "");
+        inplace_unordered_map<std::string, int, 4> map{{"one", 1}, {"two", 2}};
+        ASSERT_EQ(map.at("two"), 2);
+        map["three"] = 3;
+        assert(map.insert({"one", 10}).second == false);
+        ASSERT_EQ(map["one"], 1);
+        assert(map.try_emplace("four", 4).second);
+        assert(map.full());
+        auto full = map.try_emplace("five", 5);
+        assert(!full.second && full.first == map.end());
+        assert(!map.try_emplace("one", 11).second); // present, so not a failure
+        map.insert_or_assign("one", 100);
+        ASSERT_EQ(map.at("one"), 100);
+        assert(map.erase("two") == 1);
+        assert(map.erase("two") == 0);
+        assert(map.find("two") == map.end());
+        auto copy = map;
+        assert(copy == map);
+        auto moved = std::move(copy);
+        assert(copy.empty());
+        assert(moved == map);
+        moved["two"] = 2;
+        assert(moved != map);
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            moved["six"];
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+
+        // move-only keys, moved back by erase and out by a move of the map
+        static_assert(std::is_nothrow_move_constructible<inplace_unordered_map<std::unique_ptr<int>, int, 8>>::value, "");
+        inplace_unordered_map<std::unique_ptr<int>, int, 8> owners;
+        std::vector<int*> raw;
+        for(int idx = 0; idx != 8; ++idx) {
+            std::unique_ptr<int> key(new int(idx));
+            raw.push_back(key.get());
+            owners.try_emplace(std::move(key), idx);
+        }
+        std::unique_ptr<int> probe(raw[3]);
+        assert(owners.erase(probe) == 1);
+        static_cast<void>(probe.release());
+        auto moved_owners = std::move(owners);
+        ASSERT_EQ(moved_owners.size(), std::size_t{7});
+        for(auto& kv : moved_owners) ASSERT_EQ(*kv.first, kv.second);
+
+        // with all keys probing from the same bucket and with the default hash
+        inplace_unordered_map<int, int, 30, colliding_hash> colliding;
+        unordered_map_random_ops(colliding);
+        inplace_unordered_map<int, int, 30> plain;
+        unordered_map_random_ops(plain);
+
+        // erasing while iterating visits every element once
+        inplace_unordered_map<int, int, 30, colliding_hash> odd;
+        for(int idx = 0; idx != 30; ++idx) odd[idx] = idx;
+        std::size_t visited = 0;
+        auto erased = erase_if(odd, [&](const std::pair<const int, int>& kv) {
+            ++visited;
+            return kv.first % 2 == 0;
+        });
+        ASSERT_EQ(erased, std::size_t{15});
+        ASSERT_EQ(visited, std::size_t{30});
+        for(int idx = 0; idx != 30; ++idx) ASSERT_EQ(odd.contains(idx), idx % 2 == 1);
+    }
+
+    std::cout << "--- set algorithms\n";
+    {
+        set_algorithms<std::uint32_t>();
+        set_algorithms<std::int32_t>();
+        set_algorithms<std::uint64_t>();
+        set_algorithms<std::int64_t>();
+
+        // the largest possible union does not fit but the actual one does, so every append is checked
+        inplace_vector<std::uint32_t, 4> a{1, 2, 3}, b{2, 3, 4};
+        inplace_vector<std::uint32_t, 5> out{0};
+        set_union(a, b, out);
+        assert((out == inplace_vector<std::uint32_t, 5>{0, 1, 2, 3, 4}));
+#ifndef LYNIPV_NO_EXCEPTIONS
+        bool ex = false;
+        try {
+            merge(a, b, out);
+        } catch(const std::bad_alloc&) {
+            ex = true;
+        }
+        assert(ex);
+#endif
+    }
+
 #if __cplusplus >= 202002L
     std::cout << "--- constexpr\n";
     {
@@ -484,7 +1951,58 @@ int main() {
         static_assert(constexpr_test<unsigned, 1>());
         static_assert(constexpr_test<unsigned, 2>());
         static_assert(constexpr_test<unsigned, 3>());
+        // value-initialization leaves the elements indeterminate except in constant evaluation
+        constexpr inplace_vector<unsigned, 4> empty{};
+        static_assert(empty.empty());
+        constexpr inplace_vector<unsigned, 4> two{1, 2};
+        static_assert(two.size() == 2 && two.back() == 2);
+    }
+#if defined(__cpp_impl_coroutine)
+    std::cout << "--- inplace_channel\n";
+    {
+        inplace_channel<std::string, 2> ch;
+        std::vector<std::string> out;
+        executor exe;
+        exe.spawn(consume(ch, out)); // suspends on the empty channel
+        exe.spawn(produce(ch, 10));
+        exe.run();
+        assert(exe.done());
+        ASSERT_EQ(out.size(), std::size_t{10});
+        ASSERT_EQ(out.back(), std::string("9"));
+        assert(ch.closed() && ch.empty());
+        assert(!ch.try_send("x"));
     }
+    {
+        // a sender suspended on a full channel is resumed with false by cancel, which discards the buffer
+        inplace_channel<int, 1> ch;
+        int sent = 0;
+        executor exe;
+        exe.spawn(send_all(ch, 5, sent));
+        exe.run();
+        ASSERT_EQ(sent, 1);
+        assert(ch.full());
+        auto first = ch.try_receive(); // lets the suspended sender in
+        assert(first && *first == 0);
+        ASSERT_EQ(sent, 2);
+        ch.cancel();
+        assert(exe.done());
+        assert(ch.empty());
+        assert(!ch.try_receive());
+    }
+    {
+        // destroying a suspended coroutine takes its awaiter off the channel
+        inplace_channel<int, 1> ch;
+        int sent = 0;
+        {
+            executor exe;
+            exe.spawn(send_all(ch, 5, sent));
+            exe.run();
+            assert(!exe.done());
+        }
+        assert(ch.try_receive());
+        assert(ch.try_send(7));
+    }
+#endif
     std::cout << "--- assign_range\n";
     {
         std::vector<std::string> v1{"Hello", "world"};
@@ -517,5 +2035,19 @@ int main() {
         assert(std::equal(v1.begin(), v1.end(), r1.begin(), r1.end()));
     }
 #endif
+
+#ifdef LYNIPV_NO_EXCEPTIONS
+    // must be last since the handler does not return
+    std::cout << "--- error handler\n";
+    {
+        set_inplace_vector_error_handler([](inplace_vector_error err) {
+            std::cout << "capacity_exceeded reported to handler\n";
+            std::exit(Fail || err != inplace_vector_error::capacity_exceeded);
+        });
+        inplace_vector<int, 1> one{1};
+        one.push_back(2);
+        return 1;
+    }
+#endif
     return Fail;
 }
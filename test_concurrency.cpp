@@ -0,0 +1,133 @@
+// Multi threaded tests, built with -fsanitize=thread by the tsan target.
+// The checks are asserts, so they stay enabled in builds that define NDEBUG.
+#undef NDEBUG
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "inplace_work_stealing_deque.hpp"
+#include "seqlock_inplace_vector.hpp"
+
+using namespace lyn;
+
+namespace {
+struct route {
+    std::uint32_t generation;
+    std::uint32_t index;
+    std::uint64_t check;
+};
+
+// every update has a size and contents that follow from its generation
+inplace_vector<route, 32> routes(std::uint32_t generation) {
+    inplace_vector<route, 32> table;
+    for(std::uint32_t idx = 0; idx != generation % 32 + 1; ++idx) {
+        table.push_back(route{generation, idx, std::uint64_t{generation} * 31 + idx});
+    }
+    return table;
+}
+
+bool consistent(const inplace_vector<route, 32>& table) {
+    if(table.empty()) return false;
+    const auto generation = table[0].generation;
+    if(table.size() != generation % 32 + 1) return false;
+    for(std::uint32_t idx = 0; idx != table.size(); ++idx) {
+        if(table[idx].generation != generation || table[idx].index != idx ||
+           table[idx].check != std::uint64_t{generation} * 31 + idx) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main() {
+    std::cout << "--- inplace_work_stealing_deque, single thread\n";
+    {
+        inplace_work_stealing_deque<int, 4> deq;
+        for(int idx = 0; idx != 4; ++idx) assert(deq.try_push(idx));
+        assert(!deq.try_push(4));
+        assert(deq.size() == 4);
+        int value = -1;
+        assert(deq.pop(value) && value == 3);   // owner takes the newest
+        assert(deq.steal(value) && value == 0); // thieves take the oldest
+        assert(deq.try_push(5));
+        assert(deq.pop(value) && value == 5);
+        assert(deq.pop(value) && value == 2);
+        assert(deq.pop(value) && value == 1);
+        assert(!deq.pop(value));
+        assert(!deq.steal(value));
+        assert(deq.empty());
+    }
+
+    std::cout << "--- inplace_work_stealing_deque, owner and thieves\n";
+    {
+        constexpr std::uint32_t items = 200000;
+        constexpr int thieves = 3;
+        inplace_work_stealing_deque<std::uint32_t, 64> deq;
+        std::vector<std::atomic<int>> taken(items);
+        std::atomic<bool> done{false};
+
+        std::vector<std::thread> threads;
+        for(int thief = 0; thief != thieves; ++thief) {
+            threads.emplace_back([&] {
+                std::uint32_t value;
+                while(!done.load(std::memory_order_acquire)) {
+                    if(deq.steal(value)) taken[value].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        // the owner pushes everything, popping now and then and whenever the deque is full
+        std::uint32_t value;
+        for(std::uint32_t item = 0; item != items; ++item) {
+            while(!deq.try_push(item)) {
+                if(deq.pop(value)) taken[value].fetch_add(1, std::memory_order_relaxed);
+            }
+            if(item % 3 == 0 && deq.pop(value)) taken[value].fetch_add(1, std::memory_order_relaxed);
+        }
+        while(deq.pop(value)) taken[value].fetch_add(1, std::memory_order_relaxed);
+        // the last element may have been lost to a thief that has not recorded it yet
+        done.store(true, std::memory_order_release);
+        for(auto& thr : threads) thr.join();
+
+        for(auto& count : taken) assert(count.load() == 1);
+    }
+
+    std::cout << "--- seqlock_inplace_vector, writer and readers\n";
+    {
+        constexpr std::uint32_t updates = 20000;
+        constexpr int readers = 3;
+        seqlock_inplace_vector<route, 32> table(routes(0));
+        std::atomic<bool> done{false};
+        std::atomic<bool> failed{false};
+
+        std::vector<std::thread> threads;
+        for(int reader = 0; reader != readers; ++reader) {
+            threads.emplace_back([&] {
+                std::uint32_t last = 0;
+                while(!done.load(std::memory_order_acquire)) {
+                    const auto snap = table.snapshot();
+                    // torn copies are never returned and the generations never go backwards
+                    if(!consistent(snap) || snap[0].generation < last) failed.store(true);
+                    last = snap[0].generation;
+                }
+            });
+        }
+        for(std::uint32_t generation = 1; generation != updates; ++generation) {
+            if(generation % 2) {
+                table.store(routes(generation));
+            } else {
+                table.update([&](inplace_vector<route, 32>& copy) { copy = routes(generation); });
+            }
+        }
+        done.store(true, std::memory_order_release);
+        for(auto& thr : threads) thr.join();
+
+        assert(!failed.load());
+        const auto last = table.snapshot();
+        assert(consistent(last) && last[0].generation == updates - 1);
+        assert(table.size() == last.size());
+    }
+}
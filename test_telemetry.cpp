@@ -0,0 +1,69 @@
+// Tests of the capacity telemetry. Built with LYNIPV_TELEMETRY defined, which makes the destructors of
+// inplace_vector non-trivial, so this is kept apart from test.cpp.
+// The checks are asserts, so they stay enabled in builds that define NDEBUG.
+#undef NDEBUG
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#define LYNIPV_TELEMETRY
+#include "inplace_vector.hpp"
+
+using namespace lyn;
+
+namespace {
+const inplace_vector_telemetry_record* find(std::size_t capacity) {
+    const inplace_vector_telemetry_record* found = nullptr;
+    inplace_vector_telemetry::for_each([&](const inplace_vector_telemetry_record& rec) {
+        if(rec.capacity == capacity) found = &rec;
+    });
+    return found;
+}
+} // namespace
+
+int main() {
+    std::cout << "--- trivial\n";
+    {
+        {
+            inplace_vector<int, 16> a{1, 2, 3};
+            inplace_vector<int, 16> b(16, 0);
+            assert(b.try_push_back(1) == nullptr);
+            assert(b.try_emplace_back(1) == nullptr);
+            a.pop_back();
+        }
+        auto rec = find(16);
+        assert(rec);
+        assert(rec->instantiation().find("int") != std::string::npos);
+        assert(rec->max_size == 16);
+        assert(rec->try_failures == 2);
+        assert(rec->destroyed[2 * 8 / 16] == 1); // a, destroyed at size 2
+        assert(rec->destroyed[8] == 1);          // b, destroyed full
+    }
+    std::cout << "--- non-trivial\n";
+    {
+        {
+            inplace_vector<std::string, 8> a{"a", "b", "c", "d"};
+            auto b = std::move(a); // a is left empty
+            assert(b.try_push_back("x") != nullptr);
+        }
+        auto rec = find(8);
+        assert(rec);
+        assert(rec->instantiation().find("string") != std::string::npos);
+        assert(rec->max_size == 5);
+        assert(rec->try_failures == 0);
+        assert(rec->destroyed[0] == 1);
+        assert(rec->destroyed[5] == 1);
+    }
+    std::cout << "--- dump and reset\n";
+    {
+        std::ostringstream os;
+        inplace_vector_telemetry::dump(os);
+        std::cout << os.str();
+        assert(os.str().find("max_size=16/16 try_failures=2") != std::string::npos);
+        inplace_vector_telemetry::reset();
+        assert(find(16)->max_size == 0);
+        assert(find(16)->destroyed[8] == 0);
+        inplace_vector_telemetry::dump_at_exit();
+    }
+}